@@ -78,6 +78,24 @@ OSMutex openSensorVectorMutex = NULL;
 OSMutex multipleInstanceDeviceMutex = NULL;
 bool bMultipleInstanceDeviceMutexLocked = false;
 gtype_bool GoIOTraceEnableFlag = 0;
+GOIO_DEVICE_NOTIFICATION_CALLBACK pDeviceNotificationCallback = NULL;
+void *pDeviceNotificationContext = NULL;
+
+//Entry in the device record cache, see GoIO_SetDeviceRecordCacheFile(). Every field is a byte array, so the layout
+//on disk is the same for every platform.
+#define DDS_CACHE_KEY_SIZE 6	//GSensorDDSRec.SensorSerialNumber, GSensorDDSRec.SensorLotCode, and GSensorDDSRec.Checksum.
+struct CDeviceRecordCacheEntry
+{
+	unsigned char productId[2];	//little endian
+	unsigned char deviceSerialNumber[sizeof(GSkipGetSerialNumberCmdResponsePayload)];
+	unsigned char sensorId;
+	unsigned char ddsKey[DDS_CACHE_KEY_SIZE];
+	unsigned char ddsRec[sizeof(GSensorDDSRec)];//Marshalled, ie. exactly as stored on the sensor.
+};
+static const char kDeviceRecordCacheFileSignature[8] = { 'G', 'o', 'I', 'O', 'D', 'D', 'S', '1' };
+std::vector<CDeviceRecordCacheEntry> deviceRecordCache;
+std::string deviceRecordCacheFilePath;
+OSMutex deviceRecordCacheMutex = NULL;
 
 class CGoIOSensor
 {
@@ -98,6 +116,10 @@ public:
 		else
 			GSTD_ASSERT(false);
 		m_pMBLSensor = new GMBLSensor;
+		m_pAsyncCmdCallback = NULL;
+		m_pAsyncCmdContext = NULL;
+		memset(m_openPhaseTimesMs, 0, sizeof(m_openPhaseTimesMs));
+		memset(&m_deviceSerialNumber, 0, sizeof(m_deviceSerialNumber));
 	}
 	~CGoIOSensor()
 	{
@@ -109,6 +131,10 @@ public:
 
 	GSkipBaseDevice *m_pInterface;
 	GMBLSensor *m_pMBLSensor;
+	GOIO_CMD_COMPLETION_CALLBACK m_pAsyncCmdCallback;
+	void *m_pAsyncCmdContext;
+	gtype_int32 m_openPhaseTimesMs[GOIO_NUM_OPEN_PHASES];
+	GSkipGetSerialNumberCmdResponsePayload m_deviceSerialNumber;//All zeroes if unknown.
 };
 
 static void OpenSensorVector_Clear()
@@ -227,6 +253,282 @@ static bool OpenSensorVector_RemoveSensor(GOIO_SENSOR_HANDLE hSensor)
 	return bSuccess;
 }
 
+static bool IsValidDeviceSerialNumber(const GSkipGetSerialNumberCmdResponsePayload &serialNumber)
+{
+	const unsigned char *pBytes = (const unsigned char *) &serialNumber;
+	bool bAllZero = true;
+	bool bAllOnes = true;
+	for (unsigned int i = 0; i < sizeof(serialNumber); i++)
+	{
+		if (pBytes[i] != 0)
+			bAllZero = false;
+		if (pBytes[i] != 0xFF)
+			bAllOnes = false;
+	}
+
+	return !(bAllZero || bAllOnes);
+}
+
+static void GetDDSCacheKey(const GSensorDDSRec &marshalledRec, unsigned char *pKey)
+{
+	memcpy(pKey, marshalledRec.SensorSerialNumber, sizeof(marshalledRec.SensorSerialNumber));
+	memcpy(&pKey[sizeof(marshalledRec.SensorSerialNumber)], marshalledRec.SensorLotCode, sizeof(marshalledRec.SensorLotCode));
+	pKey[DDS_CACHE_KEY_SIZE - 1] = marshalledRec.Checksum;
+}
+
+static void DeviceRecordCache_InitEntry(
+	CDeviceRecordCacheEntry *pEntry,
+	gtype_int32 productId,
+	const GSkipGetSerialNumberCmdResponsePayload &deviceSerialNumber,
+	unsigned char sensorId)
+{
+	memset(pEntry, 0, sizeof(*pEntry));
+	pEntry->productId[0] = (unsigned char) (productId & 0xFF);
+	pEntry->productId[1] = (unsigned char) ((productId >> 8) & 0xFF);
+	memcpy(pEntry->deviceSerialNumber, &deviceSerialNumber, sizeof(pEntry->deviceSerialNumber));
+	pEntry->sensorId = sensorId;
+}
+
+static bool DeviceRecordCache_SameSensor(const CDeviceRecordCacheEntry &entry1, const CDeviceRecordCacheEntry &entry2)
+{
+	return ((0 == memcmp(entry1.productId, entry2.productId, sizeof(entry1.productId))) &&
+		(0 == memcmp(entry1.deviceSerialNumber, entry2.deviceSerialNumber, sizeof(entry1.deviceSerialNumber))) &&
+		(entry1.sensorId == entry2.sensorId));
+}
+
+//Caller must hold deviceRecordCacheMutex.
+static void DeviceRecordCache_Load()
+{
+	deviceRecordCache.clear();
+	FILE *pFile = fopen(deviceRecordCacheFilePath.c_str(), "rb");
+	if (pFile)
+	{
+		char signature[sizeof(kDeviceRecordCacheFileSignature)];
+		if ((1 == fread(signature, sizeof(signature), 1, pFile)) && 
+			(0 == memcmp(signature, kDeviceRecordCacheFileSignature, sizeof(signature))))
+		{
+			CDeviceRecordCacheEntry entry;
+			while (1 == fread(&entry, sizeof(entry), 1, pFile))
+				deviceRecordCache.push_back(entry);
+		}
+		fclose(pFile);
+	}
+}
+
+//Caller must hold deviceRecordCacheMutex.
+//The cache is written to a temporary file that then replaces the old one, so a crash part way through leaves the old cache intact.
+static void DeviceRecordCache_Save()
+{
+	std::string tempFilePath = deviceRecordCacheFilePath + ".tmp";
+	FILE *pFile = fopen(tempFilePath.c_str(), "wb");
+	if (pFile)
+	{
+		bool bSuccess = (1 == fwrite(kDeviceRecordCacheFileSignature, sizeof(kDeviceRecordCacheFileSignature), 1, pFile));
+		for (unsigned int i = 0; bSuccess && (i < deviceRecordCache.size()); i++)
+			bSuccess = (1 == fwrite(&deviceRecordCache[i], sizeof(CDeviceRecordCacheEntry), 1, pFile));
+		if (0 != fclose(pFile))
+			bSuccess = false;
+		if (bSuccess)
+		{
+#ifdef TARGET_OS_WIN
+			bSuccess = (0 != MoveFileExA(tempFilePath.c_str(), deviceRecordCacheFilePath.c_str(), MOVEFILE_REPLACE_EXISTING));
+#else
+			bSuccess = (0 == rename(tempFilePath.c_str(), deviceRecordCacheFilePath.c_str()));
+#endif
+		}
+		if (!bSuccess)
+		{
+			remove(tempFilePath.c_str());
+			GSTD_TRACE(GSTD_S("Error writing device record cache file."));
+		}
+	}
+	else
+		GSTD_TRACE(GSTD_S("Error opening device record cache file for writing."));
+}
+
+static bool DeviceRecordCache_IsEnabled()
+{
+	bool bEnabled = false;
+	if (deviceRecordCacheMutex && GThread::OSTryLockMutex(deviceRecordCacheMutex, SKIP_LIB_MNG_MUTEX_TIMEOUT_MS))
+	{
+		bEnabled = (deviceRecordCacheFilePath.size() > 0);
+		GThread::OSUnlockMutex(deviceRecordCacheMutex);
+	}
+
+	return bEnabled;
+}
+
+//On input (*pEntry) identifies the sensor and ddsKey holds the key read from the sensor.
+//Return true and fill in pEntry->ddsRec if a matching record is cached.
+static bool DeviceRecordCache_Find(CDeviceRecordCacheEntry *pEntry)
+{
+	bool bFound = false;
+	if (deviceRecordCacheMutex && GThread::OSTryLockMutex(deviceRecordCacheMutex, SKIP_LIB_MNG_MUTEX_TIMEOUT_MS))
+	{
+		//The cache may have been disabled since the caller checked, in which case it is empty.
+		for (unsigned int i = 0; i < deviceRecordCache.size(); i++)
+		{
+			if (DeviceRecordCache_SameSensor(deviceRecordCache[i], *pEntry) && 
+				(0 == memcmp(deviceRecordCache[i].ddsKey, pEntry->ddsKey, DDS_CACHE_KEY_SIZE)))
+			{
+				memcpy(pEntry->ddsRec, deviceRecordCache[i].ddsRec, sizeof(pEntry->ddsRec));
+				bFound = true;
+				break;
+			}
+		}
+
+		GThread::OSUnlockMutex(deviceRecordCacheMutex);
+	}
+
+	return bFound;
+}
+
+static void DeviceRecordCache_Store(const CDeviceRecordCacheEntry &entry)
+{
+	if (deviceRecordCacheMutex && GThread::OSTryLockMutex(deviceRecordCacheMutex, SKIP_LIB_MNG_MUTEX_TIMEOUT_MS))
+	{
+		if (deviceRecordCacheFilePath.size() > 0)
+		{
+			//Keep one record per sensor id on each device, so the file does not grow without bound.
+			unsigned int i;
+			for (i = 0; i < deviceRecordCache.size(); i++)
+			{
+				if (DeviceRecordCache_SameSensor(deviceRecordCache[i], entry))
+					break;
+			}
+			if (i < deviceRecordCache.size())
+				deviceRecordCache[i] = entry;
+			else
+				deviceRecordCache.push_back(entry);
+			DeviceRecordCache_Save();
+		}
+
+		GThread::OSUnlockMutex(deviceRecordCacheMutex);
+	}
+}
+
+//Forget all the records cached for a device.
+static void DeviceRecordCache_RemoveDevice(
+	gtype_int32 productId,
+	const GSkipGetSerialNumberCmdResponsePayload &deviceSerialNumber)
+{
+	CDeviceRecordCacheEntry entry;
+	DeviceRecordCache_InitEntry(&entry, productId, deviceSerialNumber, 0);
+	if (deviceRecordCacheMutex && GThread::OSTryLockMutex(deviceRecordCacheMutex, SKIP_LIB_MNG_MUTEX_TIMEOUT_MS))
+	{
+		bool bRemoved = false;
+		unsigned int i = 0;
+		while (i < deviceRecordCache.size())
+		{
+			if ((0 == memcmp(deviceRecordCache[i].productId, entry.productId, sizeof(entry.productId))) &&
+				(0 == memcmp(deviceRecordCache[i].deviceSerialNumber, entry.deviceSerialNumber, sizeof(entry.deviceSerialNumber))))
+			{
+				deviceRecordCache.erase(deviceRecordCache.begin() + i);
+				bRemoved = true;
+			}
+			else
+				i++;
+		}
+		if (bRemoved && (deviceRecordCacheFilePath.size() > 0))
+			DeviceRecordCache_Save();
+
+		GThread::OSUnlockMutex(deviceRecordCacheMutex);
+	}
+}
+
+//Read just the bytes of the DDS record that make up the cache key. 
+//If pDeviceSerialNumber is not NULL, then SKIP_CMD_ID_GET_SERIAL_NUMBER is sent in the same batch.
+static int ReadDDSCacheKey(
+	GSkipBaseDevice *pInterface, 
+	bool bLocal,	//[in] DDS record is in the device's own NV memory(Go! Temp), rather than on the sensor.
+	unsigned char *pKey,
+	GSkipGetSerialNumberCmdResponsePayload *pDeviceSerialNumber)
+{
+	GSkipReadI2CMemParams readSerialParams, readChecksumParams;
+	readSerialParams.addr = 2;//offsetof(GSensorDDSRec, SensorSerialNumber)
+	readSerialParams.count = DDS_CACHE_KEY_SIZE - 1;
+	readChecksumParams.addr = sizeof(GSensorDDSRec) - 1;//offsetof(GSensorDDSRec, Checksum)
+	readChecksumParams.count = 1;
+
+	GSkipPipelinedCmd cmds[3];
+	int nNumCmds = 0;
+	if (pDeviceSerialNumber)
+	{
+		cmds[nNumCmds].cmd = SKIP_CMD_ID_GET_SERIAL_NUMBER;
+		cmds[nNumCmds].pParams = NULL;
+		cmds[nNumCmds].nParamBytes = 0;
+		cmds[nNumCmds].pRespBuf = pDeviceSerialNumber;
+		cmds[nNumCmds].nRespBytes = sizeof(GSkipGetSerialNumberCmdResponsePayload);
+		nNumCmds++;
+	}
+	cmds[nNumCmds].cmd = bLocal ? SKIP_CMD_ID_READ_LOCAL_NV_MEM : SKIP_CMD_ID_READ_REMOTE_NV_MEM;
+	cmds[nNumCmds].pParams = &readSerialParams;
+	cmds[nNumCmds].nParamBytes = sizeof(readSerialParams);
+	cmds[nNumCmds].pRespBuf = pKey;
+	cmds[nNumCmds].nRespBytes = readSerialParams.count;
+	nNumCmds++;
+	cmds[nNumCmds].cmd = bLocal ? SKIP_CMD_ID_READ_LOCAL_NV_MEM : SKIP_CMD_ID_READ_REMOTE_NV_MEM;
+	cmds[nNumCmds].pParams = &readChecksumParams;
+	cmds[nNumCmds].nParamBytes = sizeof(readChecksumParams);
+	cmds[nNumCmds].pRespBuf = &pKey[DDS_CACHE_KEY_SIZE - 1];
+	cmds[nNumCmds].nRespBytes = readChecksumParams.count;
+	nNumCmds++;
+
+	int nResult = pInterface->SendCmdsAndGetResponses(cmds, nNumCmds, SKIP_TIMEOUT_MS_DEFAULT);
+	if ((kResponse_OK == nResult) && 
+		((cmds[nNumCmds - 2].nRespBytes != (int) readSerialParams.count) || (cmds[nNumCmds - 1].nRespBytes != (int) readChecksumParams.count)))
+		nResult = kResponse_Error;
+	if (pDeviceSerialNumber && (kResponse_OK != nResult))
+		memset(pDeviceSerialNumber, 0, sizeof(GSkipGetSerialNumberCmdResponsePayload));
+
+	return nResult;
+}
+
+//Read the sensor's DDS record in marshalled form. If the device record cache is enabled and the record is already 
+//in the cache, then only the cache key is read from the sensor.
+static int ReadSensorDDSRecord(
+	CGoIOSensor *pSensor,
+	gtype_int32 productId,
+	unsigned char sensorId,	//[in] 0 for Go! Temp.
+	GSensorDDSRec *pDDSRec)	//[out]
+{
+	int nResult;
+	bool bLocal = (USB_DIRECT_TEMP_DEFAULT_PRODUCT_ID == productId);
+	bool bUseCache = DeviceRecordCache_IsEnabled();
+	unsigned char ddsKey[DDS_CACHE_KEY_SIZE];
+	CDeviceRecordCacheEntry entry;
+
+	if (bUseCache)
+	{
+		//Go! Link gets the serial number while reading the flash record. Get it here for Go! Temp.
+		nResult = ReadDDSCacheKey(pSensor->m_pInterface, bLocal, ddsKey, bLocal ? &pSensor->m_deviceSerialNumber : NULL);
+		bUseCache = (kResponse_OK == nResult) && IsValidDeviceSerialNumber(pSensor->m_deviceSerialNumber);
+	}
+
+	if (bUseCache)
+	{
+		DeviceRecordCache_InitEntry(&entry, productId, pSensor->m_deviceSerialNumber, sensorId);
+		memcpy(entry.ddsKey, ddsKey, sizeof(ddsKey));
+		if (DeviceRecordCache_Find(&entry))
+		{
+			memcpy(pDDSRec, entry.ddsRec, sizeof(GSensorDDSRec));
+			return kResponse_OK;
+		}
+	}
+
+	nResult = pSensor->m_pInterface->ReadSensorDDSMemory((unsigned char *) pDDSRec, 0, sizeof(GSensorDDSRec), 
+		SKIP_TIMEOUT_MS_READ_DDSMEMBLOCK);
+
+	if (bUseCache && (kResponse_OK == nResult) && GMBLSensor::VerifyDDSChecksum(*pDDSRec, true))
+	{
+		GetDDSCacheKey(*pDDSRec, entry.ddsKey);
+		memcpy(entry.ddsRec, pDDSRec, sizeof(entry.ddsRec));
+		DeviceRecordCache_Store(entry);
+	}
+
+	return nResult;
+}
+
 /***************************************************************************************************************************
 	Function Name: GoIO_GetDLLVersion()
 		Added in version 2.00.
@@ -258,7 +560,7 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_GetDLLVersion(
 	gtype_uint16 *pMinorVersion) //[o]
 {
 	*pMajorVersion = 2;
-	*pMinorVersion = 54;
+	*pMinorVersion = 55;
 	return 0;
 }
 
@@ -299,6 +601,8 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Init()
 			if (bMultipleInstanceDeviceMutexLocked)
 				openSensorVectorMutex = GThread::OSCreateMutex(GSTD_S("GoIO_DLL_DeviceListMutex"));
 		}
+		if (openSensorVectorMutex && !deviceRecordCacheMutex)
+			deviceRecordCacheMutex = GThread::OSCreateMutex(GSTD_S("GoIO_DLL_DeviceRecordCacheMutex"));
 
 		if ((!openSensorVectorMutex) || (!hWinSetupApiLibrary) || (!hWinHidDLibrary))
 		{
@@ -328,6 +632,8 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Init()
 		{
 			if (!openSensorVectorMutex)
 				openSensorVectorMutex = GThread::OSCreateMutex(GSTD_S("GoIO_DLL_DeviceListMutex"));
+			if (!deviceRecordCacheMutex)
+				deviceRecordCacheMutex = GThread::OSCreateMutex(GSTD_S("GoIO_DLL_DeviceRecordCacheMutex"));
 		}
 
 		if (!openSensorVectorMutex)
@@ -353,8 +659,18 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Uninit()
 {
 	gtype_int32 nResult = 0;
 	
+	//Stop the device notifications first, so a callback can not open a sensor after the sensors are closed.
+	GSkipBaseDevice::OSReleaseDeviceRegistry();
+	pDeviceNotificationCallback = NULL;
+
 	OpenSensorVector_Clear();
 
+	if (deviceRecordCacheMutex)
+		GThread::OSDestroyMutex(deviceRecordCacheMutex);
+	deviceRecordCacheMutex = NULL;
+	deviceRecordCache.clear();
+	deviceRecordCacheFilePath = "";
+
 	if (openSensorVectorMutex)
 		GThread::OSDestroyMutex(openSensorVectorMutex);
 	openSensorVectorMutex = NULL;
@@ -533,55 +849,110 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_GetNthAvailableDeviceName(
 }
 
 /***************************************************************************************************************************
-	Function Name: GoIO_Sensor_Open()
+	Function Name: GoIO_SetDeviceNotificationCallback()
+		Added in version 2.55.
 	
-	Purpose:	Open a specified Go! device and the attached sensor.. 
-	
-				If the device is already open, then this routine will fail.
+	Purpose:	Register a routine that is called whenever a Go! Link, Go! Temp, Go! Motion, or Vernier Mini GC device 
+				is plugged in(bArrived = 1) or unplugged(bArrived = 0). pDeviceName is the same string that 
+				GoIO_GetNthAvailableDeviceName() reports for the device, and it is only valid for the duration of the call.
 
-				In addition to establishing basic communication with the device, this routine will initialize the
-				device. If a smart sensor is attached to the Go! device, then this routine will query the device for
-				the DDS sensor configuration parameters.
+				The callback runs on an internal GoIO thread that only delivers these notifications, one at a time and in
+				the order the devices came and went. It may call any GoIO routine except GoIO_Uninit(), including
+				GoIO_Sensor_Open() and GoIO_Sensor_Close(). While it runs, later notifications wait, but data from open
+				sensors keeps arriving. Pass in NULL to stop receiving notifications.
 
-				The following commands are sent to Go! Temp devices:
-					SKIP_CMD_ID_INIT,
-					SKIP_CMD_ID_READ_LOCAL_NV_MEM. - read DDS record
+				Once this routine or GoIO_UpdateListOfAvailableDevices() has been called, GoIO keeps its list of attached
+				devices current from the same operating system notifications, so GoIO_UpdateListOfAvailableDevices() no
+				longer needs to rescan the USB bus.
 
-				The following commands are sent to Go! Link devices:
-					SKIP_CMD_ID_INIT,
-					SKIP_CMD_ID_GET_SENSOR_ID,
-					SKIP_CMD_ID_READ_REMOTE_NV_MEM, - read DDS record if this is a 'smart' sensor
-					SKIP_CMD_ID_SET_ANALOG_INPUT_CHANNEL. - based on sensor EProbeType
+				Currently only supported on Linux builds that use libusb.
 
-				Since the device stops sending measurements in response to SKIP_CMD_ID_INIT, an application must send
-				SKIP_CMD_ID_START_MEASUREMENTS to the device in order to receive measurements.
+	Return:		0 iff successful, else -1.
 
-				At any given time, a sensor is 'owned' by only one thread. The thread that calls this routine is the
-				initial owner of the sensor. If a GoIO() call is made from a thread that does not own the sensor object
-				that is passed in, then the call will generally fail. To allow another thread to access a sensor,
-				the owning thread should call GoIO_Sensor_Unlock(), and then the new thread must call GoIO_Sensor_Lock().
-  
-	Return:		handle to open sensor device if successful, else NULL.
+****************************************************************************************************************************/
+static void DeviceNotificationHandler(int nVendorID, int nProductID, const cppstring &sDeviceName, bool bArrived, void * /*pContext*/)
+{
+	GOIO_DEVICE_NOTIFICATION_CALLBACK pCallback = pDeviceNotificationCallback;
+	if (pCallback)
+		pCallback(nVendorID, nProductID, sDeviceName.c_str(), bArrived ? 1 : 0, pDeviceNotificationContext);
+}
+
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_SetDeviceNotificationCallback(
+	GOIO_DEVICE_NOTIFICATION_CALLBACK pCallback,	//[in] NULL => disable notifications.
+	void *pContext)									//[in] passed back to pCallback.
+{
+	gtype_int32 nResult = -1;
+
+	if (NULL == pCallback)
+		GSkipBaseDevice::OSSetDeviceNotificationCallback(NULL, NULL);
+	pDeviceNotificationCallback = pCallback;
+	pDeviceNotificationContext = pContext;
+	if (NULL == pCallback)
+		nResult = 0;
+	else
+	if (kResponse_OK == GSkipBaseDevice::OSSetDeviceNotificationCallback(DeviceNotificationHandler, NULL))
+		nResult = 0;
+	else
+		pDeviceNotificationCallback = NULL;
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_SetDeviceRecordCacheFile()
+	
+	Purpose:	Enable or disable the device record cache. When the cache is enabled, GoIO_Sensor_Open() keeps a copy of each
+				smart sensor's DDS record in the specified file, so subsequent opens only have to read a few bytes of the record.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
 
 ****************************************************************************************************************************/
-GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_SetDeviceRecordCacheFile(
+	const char *pFilePath)	//[in] NULL terminated path of cache file. NULL => disable the cache.
+{
+	gtype_int32 nResult = 0;
+
+	//deviceRecordCacheMutex is created by GoIO_Init().
+	if (!deviceRecordCacheMutex)
+		nResult = -1;
+	else
+	if (!GThread::OSTryLockMutex(deviceRecordCacheMutex, SKIP_LIB_MNG_MUTEX_TIMEOUT_MS))
+		nResult = -1;
+	else
+	{
+		deviceRecordCacheFilePath = (pFilePath != NULL) ? pFilePath : "";
+		if (deviceRecordCacheFilePath.size() > 0)
+			DeviceRecordCache_Load();
+		else
+			deviceRecordCache.clear();
+
+		GThread::OSUnlockMutex(deviceRecordCacheMutex);
+	}
+
+	return nResult;
+}
+
+//Run the GoIO_Sensor_Open() sequence on one device. The calling thread owns the sensor if this succeeds.
+//The caller is responsible for checking that the device is not already open and for adding the new sensor to openSensorVector.
+static CGoIOSensor *OpenSensorDevice(
 	const char *pDeviceName,			//[in] NULL terminated string that uniquely identifies the device.
 	gtype_int32 vendorId,				//[in] USB vendor id
 	gtype_int32 productId,				//[in] USB product id
-	gtype_int32 strictDDSValidationFlag)//[in] insist on exactly valid checksum if 1, else use a more lax validation test.
+	gtype_int32 strictDDSValidationFlag,//[in] insist on exactly valid checksum if 1, else use a more lax validation test.
+	gtype_int32 *pnResult)				//[out] 0 if successful, -2 if the DDS checksum was bad, else -1.
 {
-	//First find out if this device is already open.
 	CGoIOSensor *pNewSensor = NULL;
 	GPortRef newPortRef(kPortType_USB, pDeviceName, pDeviceName, vendorId, productId);
 	int nResult = 0;
 	GSensorDDSRec DDSRec;
-	int nBytesRead;
+	gtype_int32 openPhaseTimesMs[GOIO_NUM_OPEN_PHASES];
+	unsigned int nOpenStartTime = GUtils::OSGetTimeStamp();
+	unsigned int nPhaseStartTime = nOpenStartTime;
 
-	bool bFound = OpenSensorVector_FindSensorByName(pDeviceName, vendorId, productId);
+	memset(openPhaseTimesMs, 0, sizeof(openPhaseTimesMs));
 
-	if (bFound)
-		nResult = -1;
-	else
 	if (!openSensorVectorMutex)
 		nResult = -1;
 	else
@@ -597,6 +968,8 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 		pNewSensor = new CGoIOSensor(&newPortRef);
 		pNewSensor->m_pInterface->SetDiagnosticsFlag(GoIOTraceEnableFlag != 0);
 		nResult = pNewSensor->m_pInterface->Open(&newPortRef);
+		openPhaseTimesMs[GOIO_OPEN_PHASE_DEVICE_OPEN] = GUtils::OSGetTimeStamp() - nPhaseStartTime;
+		nPhaseStartTime = GUtils::OSGetTimeStamp();
 	}
 
 	if (0 == nResult)
@@ -624,6 +997,8 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 
 		nResult = pNewSensor->m_pInterface->SendCmdAndGetResponse(SKIP_CMD_ID_INIT, pInitParams, initParamsSize, 
 								  NULL, NULL, timeoutMs);
+		openPhaseTimesMs[GOIO_OPEN_PHASE_INIT] = GUtils::OSGetTimeStamp() - nPhaseStartTime;
+		nPhaseStartTime = GUtils::OSGetTimeStamp();
 	}
 
 	if (0 == nResult)
@@ -634,8 +1009,8 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 		{
 			//This is a Jonah.
 			//Read the DDS memory.
-			nResult = pNewSensor->m_pInterface->ReadSensorDDSMemory((unsigned char *) &DDSRec, 0, sizeof(DDSRec), 
-				SKIP_TIMEOUT_MS_READ_DDSMEMBLOCK);
+			nResult = ReadSensorDDSRecord(pNewSensor, productId, 0, &DDSRec);
+			openPhaseTimesMs[GOIO_OPEN_PHASE_READ_DDS] = GUtils::OSGetTimeStamp() - nPhaseStartTime;
 			if (0 == nResult)
 			{
 				if (!GMBLSensor::VerifyDDSChecksum(DDSRec, (strictDDSValidationFlag != 0)))
@@ -659,17 +1034,16 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 			GSkipFlashMemoryRecord flashRec;
 			GSkipGetSensorIdCmdResponsePayload getSensorIdResponsePayload;
 
-			nResult = ((GSkipDevice *) pNewSensor->m_pInterface)->ReadSkipFlashRecord(&flashRec, SKIP_TIMEOUT_MS_READ_FLASH);
+			//Read the flash record and find out what sensor is connected. Both commands go out back to back.
+			//The serial number is only needed to look up the sensor's DDS record in the device record cache.
+			nResult = ((GSkipDevice *) pNewSensor->m_pInterface)->ReadSkipFlashRecordAndSensorId(&flashRec, 
+				&getSensorIdResponsePayload, SKIP_TIMEOUT_MS_READ_FLASH + SKIP_TIMEOUT_MS_DEFAULT,
+				DeviceRecordCache_IsEnabled() ? &pNewSensor->m_deviceSerialNumber : NULL);
 			if (0 == nResult)
 				((GSkipDevice *) pNewSensor->m_pInterface)->SetSkipFlashRecord(flashRec);//Do this so that measurements are properly calibrated in ConvertToVoltage().
+			openPhaseTimesMs[GOIO_OPEN_PHASE_READ_ID] = GUtils::OSGetTimeStamp() - nPhaseStartTime;
+			nPhaseStartTime = GUtils::OSGetTimeStamp();
 
-			//Find out what sensor is connected.
-			if (0 == nResult)
-			{
-				nBytesRead = sizeof(GSkipGetSensorIdCmdResponsePayload);
-				nResult = pNewSensor->m_pInterface->SendCmdAndGetResponse(SKIP_CMD_ID_GET_SENSOR_ID, NULL, 0, 
-					&getSensorIdResponsePayload, &nBytesRead);
-			}
 			if (0 == nResult)
 			{
 				//Parse out sensor id.
@@ -688,8 +1062,9 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 				if (pNewSensor->m_pMBLSensor->IsSmartSensor())
 				{
 					//Read the DDS memory.
-					nResult = pNewSensor->m_pInterface->ReadSensorDDSMemory((unsigned char *) &DDSRec, 0, sizeof(DDSRec), 
-						SKIP_TIMEOUT_MS_READ_DDSMEMBLOCK);
+					nResult = ReadSensorDDSRecord(pNewSensor, productId, (unsigned char) nSensorId, &DDSRec);
+					openPhaseTimesMs[GOIO_OPEN_PHASE_READ_DDS] = GUtils::OSGetTimeStamp() - nPhaseStartTime;
+					nPhaseStartTime = GUtils::OSGetTimeStamp();
 					if (0 == nResult)
 					{
 						if (!GMBLSensor::VerifyDDSChecksum(DDSRec, (strictDDSValidationFlag != 0)))
@@ -708,10 +1083,22 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 
 				nResult = pNewSensor->m_pInterface->SendCmdAndGetResponse(SKIP_CMD_ID_SET_ANALOG_INPUT_CHANNEL, 
 					&setAnalogInputChannelParams, sizeof(GSkipSetAnalogInputChannelParams), NULL, NULL);
+				openPhaseTimesMs[GOIO_OPEN_PHASE_CONFIGURE] = GUtils::OSGetTimeStamp() - nPhaseStartTime;
 			}
 		}
 	}
 
+	openPhaseTimesMs[GOIO_OPEN_PHASE_TOTAL] = GUtils::OSGetTimeStamp() - nOpenStartTime;
+	cppsstream ss;
+	ss << GSTD_S("GoIO_Sensor_Open() result = ") << nResult;
+	ss << GSTD_S(", open = ") << openPhaseTimesMs[GOIO_OPEN_PHASE_DEVICE_OPEN];
+	ss << GSTD_S(" ms, init = ") << openPhaseTimesMs[GOIO_OPEN_PHASE_INIT];
+	ss << GSTD_S(" ms, id = ") << openPhaseTimesMs[GOIO_OPEN_PHASE_READ_ID];
+	ss << GSTD_S(" ms, dds = ") << openPhaseTimesMs[GOIO_OPEN_PHASE_READ_DDS];
+	ss << GSTD_S(" ms, configure = ") << openPhaseTimesMs[GOIO_OPEN_PHASE_CONFIGURE];
+	ss << GSTD_S(" ms, total = ") << openPhaseTimesMs[GOIO_OPEN_PHASE_TOTAL] << GSTD_S(" ms.");
+	GSTD_TRACE(ss.str());
+
 	if (0 != nResult)
 	{
 		if (pNewSensor)
@@ -719,76 +1106,290 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 		pNewSensor = NULL;
 	}
 	else
-		//Add new sensor to list of open devices.
-		OpenSensorVector_AddSensor(pNewSensor);
+		memcpy(pNewSensor->m_openPhaseTimesMs, openPhaseTimesMs, sizeof(openPhaseTimesMs));
 
+	(*pnResult) = nResult;
 	return pNewSensor;
 }
 
+struct COpenSensorRequest
+{
+	const char *pDeviceName;
+	gtype_int32 vendorId;
+	gtype_int32 productId;
+	gtype_int32 strictDDSValidationFlag;
+	CGoIOSensor *pSensor;
+	gtype_int32 nResult;
+};
+
+static int OpenSensorDeviceThreadFunc(void *pParam)
+{
+	COpenSensorRequest *pRequest = (COpenSensorRequest *) pParam;
+	pRequest->pSensor = OpenSensorDevice(pRequest->pDeviceName, pRequest->vendorId, pRequest->productId, 
+		pRequest->strictDDSValidationFlag, &pRequest->nResult);
+
+	//Give up ownership so that the thread that called GoIO_Sensor_OpenMany() can take it over.
+	if (pRequest->pSensor)
+		pRequest->pSensor->m_pInterface->UnlockDevice();
+
+	return 0;
+}
+
+
 /***************************************************************************************************************************
-	Function Name: GoIO_Sensor_Close()
+	Function Name: GoIO_Sensor_Open()
 	
-	Purpose:	Close a specified sensor. After this routine succeeds the hSensor handle is no longer valid.
+	Purpose:	Open a specified Go! device and the attached sensor.. 
 	
-	Return:		0 if successful, else -1.
+				If the device is already open, then this routine will fail.
 
-****************************************************************************************************************************/
-GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_Close(
-	GOIO_SENSOR_HANDLE hSensor)	//[in] handle to open sensor.
-{
-	gtype_int32 nResult = 0;
-	if (!OpenSensorVector_FindAndLockSensor(hSensor))
-		nResult = -1;
-	else
-	{
-		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+				In addition to establishing basic communication with the device, this routine will initialize the
+				device. If a smart sensor is attached to the Go! device, then this routine will query the device for
+				the DDS sensor configuration parameters.
 
-		if (0 == (pGoIOSensor->m_pInterface->GetHostIOStatus() & SKIP_HOST_IO_STATUS_TIMED_OUT))
-		{
-			GSkipSetLedStateParams ledParams;		//Set the LED back to orange.
-			ledParams.color = kLEDOrange;
-			ledParams.brightness = kSkipOrangeLedBrightness;
-			pGoIOSensor->m_pInterface->SendCmdAndGetResponse(SKIP_CMD_ID_SET_LED_STATE, &ledParams, sizeof(ledParams), NULL, NULL);
+				The following commands are sent to Go! Temp devices:
+					SKIP_CMD_ID_INIT,
+					SKIP_CMD_ID_READ_LOCAL_NV_MEM. - read DDS record
 
-			if (pGoIOSensor->m_pInterface->AreMeasurementsEnabled())
-				pGoIOSensor->m_pInterface->SendCmd(SKIP_CMD_ID_STOP_MEASUREMENTS, NULL, 0);
-		}
+				The following commands are sent to Go! Link devices:
+					SKIP_CMD_ID_INIT,
+					SKIP_CMD_ID_GET_SENSOR_ID,
+					SKIP_CMD_ID_READ_REMOTE_NV_MEM, - read DDS record if this is a 'smart' sensor
+					SKIP_CMD_ID_SET_ANALOG_INPUT_CHANNEL. - based on sensor EProbeType
 
-		pGoIOSensor->m_pInterface->Close();
+				Since the device stops sending measurements in response to SKIP_CMD_ID_INIT, an application must send
+				SKIP_CMD_ID_START_MEASUREMENTS to the device in order to receive measurements.
 
-		OpenSensorVector_RemoveSensor(hSensor);
+				At any given time, a sensor is 'owned' by only one thread. The thread that calls this routine is the
+				initial owner of the sensor. If a GoIO() call is made from a thread that does not own the sensor object
+				that is passed in, then the call will generally fail. To allow another thread to access a sensor,
+				the owning thread should call GoIO_Sensor_Unlock(), and then the new thread must call GoIO_Sensor_Lock().
+  
+	Return:		handle to open sensor device if successful, else NULL.
 
-		UnlockSensor(hSensor);
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
+	const char *pDeviceName,			//[in] NULL terminated string that uniquely identifies the device.
+	gtype_int32 vendorId,				//[in] USB vendor id
+	gtype_int32 productId,				//[in] USB product id
+	gtype_int32 strictDDSValidationFlag)//[in] insist on exactly valid checksum if 1, else use a more lax validation test.
+{
+	CGoIOSensor *pNewSensor = NULL;
+	gtype_int32 nResult = -1;
 
-		delete pGoIOSensor;
-	}
+	//First find out if this device is already open.
+	bool bFound = OpenSensorVector_FindSensorByName(pDeviceName, vendorId, productId);
 
-	return nResult;
+	if (!bFound)
+		pNewSensor = OpenSensorDevice(pDeviceName, vendorId, productId, strictDDSValidationFlag, &nResult);
+
+	if (pNewSensor)
+		//Add new sensor to list of open devices.
+		OpenSensorVector_AddSensor(pNewSensor);
+
+	return pNewSensor;
 }
 
 /***************************************************************************************************************************
-	Function Name: GoIO_Sensor_GetOpenDeviceName()
+	Function Name: GoIO_Sensor_OpenMany()
 	
-	Purpose:	Get the unique device name string and USB id's for a specified open device.
+	Purpose:	Open several Go! devices at once. Each device goes through the same sequence as GoIO_Sensor_Open(), but
+				the devices are opened concurrently, so bringing up N devices takes about as long as opening the slowest one.
 
-	Return:		0 iff successful, else -1.
+				The thread that calls this routine is the initial owner of all the sensors that are opened.
+
+				Added in version 2.55.
+	
+	Return:		number of sensors successfully opened.
 
 ****************************************************************************************************************************/
-GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetOpenDeviceName(
-	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
-	char *pBuf,				//[out] ptr to buffer to store device name string.
-	gtype_int32 bufSize,	//[in] number of bytes in buffer pointed to by pBuf. Strlen(pBuf) < bufSize, because the string is NULL terminated.
-	gtype_int32 *pVendorId,	//[out]
-	gtype_int32 *pProductId)//[out]
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_OpenMany(
+	gtype_int32 numDevices,				//[in] number of entries in each of the arrays.
+	const char *pDeviceNames[],			//[in] NULL terminated strings that uniquely identify the devices.
+	const gtype_int32 vendorIds[],		//[in] USB vendor ids
+	const gtype_int32 productIds[],		//[in] USB product ids
+	gtype_int32 strictDDSValidationFlag,//[in] insist on exactly valid checksum if 1, else use a more lax validation test.
+	GOIO_SENSOR_HANDLE hSensorsOut[],	//[out] handle to each open sensor, NULL if that device failed to open.
+	gtype_int32 statusOut[])			//[out] 0 if the device opened, -2 if its DDS checksum was bad, else -1. May be NULL.
 {
-	GSTD_ASSERT(pBuf != NULL);
-	GSTD_ASSERT(bufSize > 0);
-	gtype_int32 nResult = 0;
-	if (!OpenSensorVector_FindAndLockSensor(hSensor))
-		nResult = -1;
-	else
-	{
-		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+	gtype_int32 nNumOpened = 0;
+	int i, j;
+
+	if ((numDevices <= 0) || (NULL == pDeviceNames) || (NULL == vendorIds) || (NULL == productIds) || (NULL == hSensorsOut))
+		return 0;
+
+	COpenSensorRequest *pRequests = new COpenSensorRequest[numDevices];
+	GLiteThread **ppThreads = new GLiteThread *[numDevices];
+
+	for (i = 0; i < numDevices; i++)
+	{
+		pRequests[i].pDeviceName = pDeviceNames[i];
+		pRequests[i].vendorId = vendorIds[i];
+		pRequests[i].productId = productIds[i];
+		pRequests[i].strictDDSValidationFlag = strictDDSValidationFlag;
+		pRequests[i].pSensor = NULL;
+		pRequests[i].nResult = -1;
+		ppThreads[i] = NULL;
+
+		if (NULL == pDeviceNames[i])
+			continue;
+		if (OpenSensorVector_FindSensorByName(pDeviceNames[i], vendorIds[i], productIds[i]))
+			continue;
+
+		bool bDuplicate = false;
+		for (j = 0; j < i; j++)
+		{
+			if (pDeviceNames[j] && (0 == strcmp(pDeviceNames[i], pDeviceNames[j])) && 
+					(vendorIds[i] == vendorIds[j]) && (productIds[i] == productIds[j]))
+				bDuplicate = true;
+		}
+		if (bDuplicate)
+			continue;
+
+		ppThreads[i] = new GLiteThread(OpenSensorDeviceThreadFunc, NULL, &pRequests[i]);
+		if (!ppThreads[i]->OSStartThread())
+		{
+			delete ppThreads[i];
+			ppThreads[i] = NULL;
+		}
+	}
+
+	for (i = 0; i < numDevices; i++)
+	{
+		if (ppThreads[i])
+		{
+			//OSStopThread() waits for the thread to exit, after which its results in pRequests[i] are safe to read.
+			ppThreads[i]->OSStopThread();
+			delete ppThreads[i];
+		}
+
+		CGoIOSensor *pNewSensor = pRequests[i].pSensor;
+		if (pNewSensor)
+		{
+			if (pNewSensor->m_pInterface->LockDevice(SKIP_LIB_MNG_MUTEX_TIMEOUT_MS))
+			{
+				//Add new sensor to list of open devices.
+				OpenSensorVector_AddSensor(pNewSensor);
+				nNumOpened++;
+			}
+			else
+			{
+				GSTD_ASSERT(0);
+				delete pNewSensor;
+				pNewSensor = NULL;
+				pRequests[i].nResult = -1;
+			}
+		}
+
+		hSensorsOut[i] = pNewSensor;
+		if (statusOut)
+			statusOut[i] = pRequests[i].nResult;
+	}
+
+	delete [] ppThreads;
+	delete [] pRequests;
+
+	return nNumOpened;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetOpenPhaseTimings()
+	
+	Purpose:	Report how long each phase of GoIO_Sensor_Open() took for the specified sensor.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetOpenPhaseTimings(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	gtype_int32 *pTimesMs,		//[out] ptr to array of numTimes elapsed times in milliseconds, indexed by GOIO_OPEN_PHASE_*.
+	gtype_int32 numTimes)		//[in] # of elements in pTimesMs. Pass in GOIO_NUM_OPEN_PHASES.
+{
+	gtype_int32 nResult = 0;
+	if ((NULL == pTimesMs) || (numTimes <= 0))
+		nResult = -1;
+	else
+	if (!OpenSensorVector_FindAndLockSensor(hSensor))
+		nResult = -1;
+	else
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		if (numTimes > GOIO_NUM_OPEN_PHASES)
+			numTimes = GOIO_NUM_OPEN_PHASES;
+		memcpy(pTimesMs, pGoIOSensor->m_openPhaseTimesMs, numTimes*sizeof(gtype_int32));
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_Close()
+	
+	Purpose:	Close a specified sensor. After this routine succeeds the hSensor handle is no longer valid.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_Close(
+	GOIO_SENSOR_HANDLE hSensor)	//[in] handle to open sensor.
+{
+	gtype_int32 nResult = 0;
+	if (!OpenSensorVector_FindAndLockSensor(hSensor))
+		nResult = -1;
+	else
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+
+		if (0 == (pGoIOSensor->m_pInterface->GetHostIOStatus() & SKIP_HOST_IO_STATUS_TIMED_OUT))
+		{
+			GSkipSetLedStateParams ledParams;		//Set the LED back to orange.
+			ledParams.color = kLEDOrange;
+			ledParams.brightness = kSkipOrangeLedBrightness;
+			pGoIOSensor->m_pInterface->SendCmdAndGetResponse(SKIP_CMD_ID_SET_LED_STATE, &ledParams, sizeof(ledParams), NULL, NULL);
+
+			if (pGoIOSensor->m_pInterface->AreMeasurementsEnabled())
+				pGoIOSensor->m_pInterface->SendCmd(SKIP_CMD_ID_STOP_MEASUREMENTS, NULL, 0);
+		}
+
+		pGoIOSensor->m_pInterface->Close();
+
+		OpenSensorVector_RemoveSensor(hSensor);
+
+		UnlockSensor(hSensor);
+
+		delete pGoIOSensor;
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetOpenDeviceName()
+	
+	Purpose:	Get the unique device name string and USB id's for a specified open device.
+
+	Return:		0 iff successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetOpenDeviceName(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	char *pBuf,				//[out] ptr to buffer to store device name string.
+	gtype_int32 bufSize,	//[in] number of bytes in buffer pointed to by pBuf. Strlen(pBuf) < bufSize, because the string is NULL terminated.
+	gtype_int32 *pVendorId,	//[out]
+	gtype_int32 *pProductId)//[out]
+{
+	GSTD_ASSERT(pBuf != NULL);
+	GSTD_ASSERT(bufSize > 0);
+	gtype_int32 nResult = 0;
+	if (!OpenSensorVector_FindAndLockSensor(hSensor))
+		nResult = -1;
+	else
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
 		GPortRef portRef = pGoIOSensor->m_pInterface->GetPortRef();
 		*pVendorId = portRef.GetUSBVendorID();
 		*pProductId = portRef.GetUSBProductID();
@@ -1062,6 +1663,113 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetNextResponse(
 }
 
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_SendCmdAsync()
+	
+	Purpose:	Send a command to the specified Go! device without waiting for the response. 
+				Poll GoIO_Sensor_CheckAsyncCmd() to complete the command.
+
+				Added in version 2.55.
+	
+	Return:		0 if the command was sent, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_SendCmdAsync(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	unsigned char cmd,			//[in] command code. See SKIP_CMD_ID_* in GSkipCommExt.h.
+	void *pParams,				//[in] ptr to cmd specific parameter block, may be NULL. See GSkipCommExt.h.
+	gtype_int32 nParamBytes,	//[in] # of bytes in (*pParams).
+	gtype_int32 timeoutMs,		//[in] # of milliseconds to wait for a reply before GoIO_Sensor_CheckAsyncCmd() gives up.
+	GOIO_CMD_COMPLETION_CALLBACK pCallback,//[in] called when the command completes, may be NULL.
+	void *pContext)				//[in] passed back to pCallback.
+{
+	gtype_int32 nResult = 0;
+	if (!OpenSensorVector_FindAndLockSensor(hSensor))
+		nResult = -1;
+	else
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		nResult = pGoIOSensor->m_pInterface->SendCmdAsync(cmd, pParams, nParamBytes, timeoutMs);
+		if (0 == nResult)
+		{
+			pGoIOSensor->m_pAsyncCmdCallback = pCallback;
+			pGoIOSensor->m_pAsyncCmdContext = pContext;
+		}
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_CheckAsyncCmd()
+	
+	Purpose:	Check whether the command sent by GoIO_Sensor_SendCmdAsync() has completed, without blocking. 
+				On completion, the callback passed to GoIO_Sensor_SendCmdAsync() is invoked.
+
+				Added in version 2.55.
+	
+	Return:		1 if the command is still pending, 0 if it completed successfully, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_CheckAsyncCmd(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	void *pRespBuf,				//[out] ptr to destination buffer, may be NULL. See GSkipCommExt.h.
+	gtype_int32 *pnRespBytes)	//[in, out] ptr to size of of pRespBuf buffer on input, size of response on output, may be NULL if pRespBuf is NULL.
+{
+	gtype_int32 nResult = 0;
+	unsigned char respBuf[256];
+	int nRespBytes = sizeof(respBuf);
+	bool bComplete = false;
+	unsigned char cmd = 0;
+	unsigned char lastCmdStatus = 0;
+	unsigned char lastErrorSentOvertheWire = 0;
+	GOIO_CMD_COMPLETION_CALLBACK pCallback = NULL;
+	void *pContext = NULL;
+
+	if (!OpenSensorVector_FindAndLockSensor(hSensor))
+		nResult = -1;
+	else
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		nResult = pGoIOSensor->m_pInterface->CheckAsyncCmdResponse(respBuf, &nRespBytes, &bComplete);
+		if (!bComplete)
+		{
+			if (0 == nResult)
+				nResult = 1;
+			nRespBytes = 0;
+		}
+		else
+		{
+			pGoIOSensor->m_pInterface->GetAsyncCmdResponseStatus(&cmd, &lastCmdStatus, &lastErrorSentOvertheWire);
+			pCallback = pGoIOSensor->m_pAsyncCmdCallback;
+			pContext = pGoIOSensor->m_pAsyncCmdContext;
+			pGoIOSensor->m_pAsyncCmdCallback = NULL;
+			pGoIOSensor->m_pAsyncCmdContext = NULL;
+		}
+
+		UnlockSensor(hSensor);
+	}
+
+	//Only the caller's copy is limited to its buffer, the callback gets the whole response.
+	if (pnRespBytes)
+	{
+		int nCopyBytes = nRespBytes;
+		if (nCopyBytes > (*pnRespBytes))
+			nCopyBytes = (*pnRespBytes);
+		if (pRespBuf && (nCopyBytes > 0))
+			memcpy(pRespBuf, respBuf, nCopyBytes);
+		(*pnRespBytes) = nCopyBytes;
+	}
+
+	//Call back without holding the sensor lock, so the callback is free to send the next command.
+	if (bComplete && pCallback)
+		pCallback(hSensor, cmd, (nResult == 0) ? 0 : -1, respBuf, nRespBytes, lastCmdStatus, lastErrorSentOvertheWire, pContext);
+
+	return nResult;
+}
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_GetMeasurementTickInSeconds()
 	
@@ -1227,6 +1935,8 @@ GOIO_DLL_INTERFACE_DECL gtype_real64 GoIO_Sensor_GetMeasurementPeriod(
 				oldest measurements in the buffer are lost. If you wish to capture all the 
 				measurements coming from the sensor, you must call GoIO_Sensor_ReadRawMeasurements()
 				often enough so that the GoIO_Sensor_GetNumMeasurementsAvailable() does not reach 1000.
+				On Linux, GoIO_Sensor_SetMeasurementBufferOptions() makes the buffer larger and selects what happens
+				when it is full.
 
 				Each of the following actions clears the GoIO Measurement Buffer:
 					1) Call GoIO_Sensor_ReadRawMeasurements() with count set to GoIO_Sensor_GetNumMeasurementsAvailable(), or
@@ -1258,6 +1968,148 @@ GOIO_SENSOR_HANDLE hSensor)	//[in] handle to open sensor.
 	return nResult;
 }
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_SetMeasurementBufferOptions()
+	
+	Purpose:	Resize the GoIO Measurement Buffer of the specified sensor and choose what happens when it overflows.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_SetMeasurementBufferOptions(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	gtype_int32 capacity,		//[in] GOIO_MIN_MEAS_BUFFER_CAPACITY to GOIO_MAX_MEAS_BUFFER_CAPACITY measurements.
+	gtype_int32 overflowPolicy,	//[in] GOIO_MEAS_BUFFER_OVERFLOW_*
+	gtype_int32 blockTimeoutMs)	//[in] 0 to GOIO_MAX_MEAS_BUFFER_BLOCK_TIMEOUT_MS.
+{
+	gtype_int32 nResult = -1;
+	if ((capacity >= GOIO_MIN_MEAS_BUFFER_CAPACITY) && (capacity <= GOIO_MAX_MEAS_BUFFER_CAPACITY) &&
+		(blockTimeoutMs >= 0) && (blockTimeoutMs <= GOIO_MAX_MEAS_BUFFER_BLOCK_TIMEOUT_MS) &&
+		OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		int nPolicy = -1;
+		if (GOIO_MEAS_BUFFER_OVERFLOW_DROP_OLDEST == overflowPolicy)
+			nPolicy = kPacketQueueOverflow_DropOldest;
+		else if (GOIO_MEAS_BUFFER_OVERFLOW_DROP_NEWEST == overflowPolicy)
+			nPolicy = kPacketQueueOverflow_DropNewest;
+		else if (GOIO_MEAS_BUFFER_OVERFLOW_BLOCK == overflowPolicy)
+			nPolicy = kPacketQueueOverflow_BlockProducer;
+
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		if ((nPolicy >= 0) && 
+			(kResponse_OK == pGoIOSensor->m_pInterface->OSSetMeasurementQueueOptions(capacity, nPolicy, blockTimeoutMs)))
+			nResult = 0;
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetMeasurementBufferOverflowCount()
+	
+	Purpose:	Report how many measurements the GoIO Measurement Buffer of the specified sensor has discarded
+				because it was full.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetMeasurementBufferOverflowCount(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_uint32 *pOverflowCount)	//[out] # of measurements discarded.
+{
+	gtype_int32 nResult = -1;
+	if ((NULL != pOverflowCount) && OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		unsigned int nNumDropped = 0;
+		if (kResponse_OK == pGoIOSensor->m_pInterface->OSGetMeasurementQueueOverflowCount(&nNumDropped))
+		{
+			(*pOverflowCount) = nNumDropped;
+			nResult = 0;
+		}
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetStreamIntegrity()
+	
+	Purpose:	Report whether the measurements read from the specified sensor form a complete stream.
+
+				Every measurement packet carries a rolling counter, so each measurement has an 8 bit sequence number.
+				As measurements are read by GoIO_Sensor_ReadRawMeasurements() or GoIO_Sensor_GetLatestRawMeasurement(),
+				breaks in the sequence are recorded as gaps. A gap covers packets lost between the sensor and the host
+				as well as measurements discarded by a full GoIO Measurement Buffer(see GoIO_Sensor_SetMeasurementBufferOptions()).
+				Measurements discarded by GoIO_Sensor_ClearIO() are not counted, and neither is the time between
+				SKIP_CMD_ID_STOP_MEASUREMENTS and the next SKIP_CMD_ID_START_MEASUREMENTS.
+
+				Because the sequence number is only 8 bits, a single gap of 256 or more measurements is under reported
+				by a multiple of 256. GoIO_Sensor_GetMeasurementBufferOverflowCount() reports buffer overflows exactly.
+
+				The most recent GOIO_MAX_STREAM_GAPS_RECORDED gaps are kept. Each gap is reported as the number of
+				measurements read before the gap(its position in the stream) and the number of measurements missing.
+				The lost packet count is an estimate, based on the number of measurements per packet.
+
+				All counts start at 0 when the sensor is opened.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetStreamIntegrity(
+	GOIO_SENSOR_HANDLE hSensor,				//[in] handle to open sensor.
+	gtype_uint64 *pNumMeasurementsRead,		//[out] # of measurements read since the sensor was opened.
+	gtype_uint64 *pNumLostPackets,			//[out] estimated # of measurement packets lost.
+	gtype_uint64 *pNumLostMeasurements,		//[out] # of measurements lost.
+	gtype_uint32 *pNumGaps,					//[out] # of gaps since the sensor was opened.
+	gtype_uint64 *pGapPositions,			//[out] ptr to array of *pIONumGaps stream positions, oldest gap first. May be NULL.
+	gtype_uint32 *pGapNumMissing,			//[out] ptr to array of *pIONumGaps measurement counts. May be NULL.
+	gtype_int32 *pIONumGaps)	//[in, out] size of the gap arrays on input, # of gaps copied on output. May be NULL.
+{
+	gtype_int32 nResult = -1;
+	if ((NULL != pNumMeasurementsRead) && (NULL != pNumLostPackets) && (NULL != pNumLostMeasurements) && (NULL != pNumGaps) &&
+		OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		GSkipStreamGap gaps[SKIP_MAX_STREAM_GAPS_RECORDED];
+		int nNumGaps = 0;
+		if (pIONumGaps && pGapPositions && pGapNumMissing)
+			nNumGaps = ((*pIONumGaps) < SKIP_MAX_STREAM_GAPS_RECORDED) ? (*pIONumGaps) : SKIP_MAX_STREAM_GAPS_RECORDED;
+		unsigned long long nNumRead, nNumLostPackets, nNumLostMeasurements;
+		unsigned int nNumGapsTotal;
+		if (kResponse_OK == pGoIOSensor->m_pInterface->GetStreamIntegrity(&nNumRead, &nNumLostPackets, &nNumLostMeasurements, 
+			&nNumGapsTotal, gaps, &nNumGaps))
+		{
+			(*pNumMeasurementsRead) = nNumRead;
+			(*pNumLostPackets) = nNumLostPackets;
+			(*pNumLostMeasurements) = nNumLostMeasurements;
+			(*pNumGaps) = nNumGapsTotal;
+			for (int i = 0; i < nNumGaps; i++)
+			{
+				pGapPositions[i] = gaps[i].nPosition;
+				pGapNumMissing[i] = gaps[i].nNumMissing;
+			}
+			if (pIONumGaps)
+				(*pIONumGaps) = nNumGaps;
+			nResult = 0;
+		}
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_ReadRawMeasurements()
 	
@@ -1287,11 +2139,137 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadRawMeasurements(
 	gtype_int32 nResult = 0;
 	if (OpenSensorVector_FindAndLockSensor(hSensor))
 	{
-		intVector vec;
 		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
-		vec = pGoIOSensor->m_pInterface->ReadRawMeasurements(maxCount);
-		for (nResult = 0; (nResult < (gtype_int32)vec.size()) && (nResult < maxCount); nResult++)
-			pMeasurementsBuf[nResult] = vec[nResult];
+		if ((pMeasurementsBuf != NULL) && (maxCount > 0))
+			nResult = pGoIOSensor->m_pInterface->ReadRawMeasurementsInto(pMeasurementsBuf, maxCount);
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadRawMeasurementsWithTimestamps()
+	
+	Purpose:	Same as GoIO_Sensor_ReadRawMeasurements(), but also report when each measurement arrived.
+
+				pTimestampsBuf[i] is the time at which the packet carrying pMeasurementsBuf[i] was received by the
+				host, in nanoseconds on the CLOCK_MONOTONIC clock(see clock_gettime()). Measurements that came in the
+				same packet have the same timestamp. The timestamps measure when the packet reached the application
+				side of the USB stack, so they include bus and scheduling latency.
+
+				Arrival times are currently only recorded on Linux. On other platforms the timestamps are 0.
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer. This routine
+				returns immediately, so the return value may be less than maxCount.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadRawMeasurementsWithTimestamps(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurementsBuf,	//[out] ptr to loc to store measurements.
+	gtype_uint64 *pTimestampsBuf,	//[out] ptr to loc to store arrival times in nanoseconds.
+	gtype_int32 maxCount)	//[in] maximum number of measurements to copy to pMeasurementsBuf and pTimestampsBuf.
+{
+	gtype_int32 nResult = 0;
+	if (OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		if ((pMeasurementsBuf != NULL) && (pTimestampsBuf != NULL) && (maxCount > 0))
+			nResult = pGoIOSensor->m_pInterface->ReadRawMeasurementsInto(pMeasurementsBuf, maxCount, pTimestampsBuf);
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadRawMeasurementsWithEstimatedTimes()
+	
+	Purpose:	Same as GoIO_Sensor_ReadRawMeasurements(), but also report when each measurement was taken, in nanoseconds
+				on the host CLOCK_MONOTONIC clock.
+
+				The sensor takes measurements on its own clock, which drifts relative to the host clock. The times reported
+				here come from a per sensor timeline estimator that fits the arrival times of the packets against the
+				position of each measurement in the stream(including lost measurements, see GoIO_Sensor_GetStreamIntegrity()),
+				using the measurement period as the starting point. Unlike the raw arrival times reported by 
+				GoIO_Sensor_ReadRawMeasurementsWithTimestamps(), consecutive estimated times are evenly spaced, and times from
+				different sensors can be compared directly. The estimate is aligned with the average arrival time, so it
+				includes the average USB latency.
+
+				The estimator restarts whenever SKIP_CMD_ID_SET_MEASUREMENT_PERIOD or SKIP_CMD_ID_START_MEASUREMENTS succeeds, and
+				after GoIO_Sensor_ClearIO(). It does not run until the measurement period has been set with 
+				GoIO_Sensor_SetMeasurementPeriod() after the sensor was opened. Times are 0 until the estimator has an arrival
+				time to work from. See GoIO_Sensor_GetTimelineEstimate().
+
+				Arrival times are currently only recorded on Linux. On other platforms the estimated times are 0.
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer. This routine
+				returns immediately, so the return value may be less than maxCount.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadRawMeasurementsWithEstimatedTimes(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurementsBuf,	//[out] ptr to loc to store measurements.
+	gtype_uint64 *pTimesBuf,		//[out] ptr to loc to store estimated measurement times in nanoseconds.
+	gtype_int32 maxCount)	//[in] maximum number of measurements to copy to pMeasurementsBuf and pTimesBuf.
+{
+	gtype_int32 nResult = 0;
+	if (OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		if ((pMeasurementsBuf != NULL) && (pTimesBuf != NULL) && (maxCount > 0))
+			nResult = pGoIOSensor->m_pInterface->ReadRawMeasurementsInto(pMeasurementsBuf, maxCount, NULL, pTimesBuf);
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetTimelineEstimate()
+	
+	Purpose:	Report the state of the timeline estimator used by GoIO_Sensor_ReadRawMeasurementsWithEstimatedTimes().
+
+				*pPeriodInSeconds is the measurement period as measured by the host clock.
+				*pDriftPpm is how much faster(positive) or slower(negative) the sensor clock runs than the host clock,
+				in parts per million.
+				*pJitterInSeconds is the rms deviation of the packet arrival times from the fitted timeline.
+				*pNumPoints is the number of arrival times the estimate is based on. Every arrival counts equally, so the
+				estimate keeps improving during a long capture.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, -1 if there is no estimate yet(fewer than 2 arrival times since the estimator restarted).
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetTimelineEstimate(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_real64 *pPeriodInSeconds,	//[out]
+	gtype_real64 *pDriftPpm,		//[out]
+	gtype_real64 *pJitterInSeconds,	//[out]
+	gtype_uint32 *pNumPoints)	//[out]
+{
+	gtype_int32 nResult = -1;
+	if (pPeriodInSeconds && pDriftPpm && pJitterInSeconds && pNumPoints && OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		real fPeriod, fDrift, fJitter;
+		unsigned int nNumPoints;
+		if (kResponse_OK == pGoIOSensor->m_pInterface->GetTimelineEstimate(&fPeriod, &fDrift, &fJitter, &nNumPoints))
+		{
+			(*pPeriodInSeconds) = fPeriod;
+			(*pDriftPpm) = fDrift;
+			(*pJitterInSeconds) = fJitter;
+			(*pNumPoints) = nNumPoints;
+			nResult = 0;
+		}
 
 		UnlockSensor(hSensor);
 	}
@@ -1340,6 +2318,212 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetLatestRawMeasurement(
 	return nResult;
 }
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_PeekLatestMeasurement()
+	
+	Purpose:	Report the most recent measurement received from the sensor, and when it arrived, without removing
+				anything from the GoIO Measurement Buffer.
+
+				Unlike GoIO_Sensor_GetLatestRawMeasurement(), this routine does not empty the GoIO Measurement Buffer,
+				and it takes the same short time however many measurements are waiting. So one thread can poll the
+				current value while another thread reads the full stream with GoIO_Sensor_ReadRawMeasurements().
+
+				The value is updated as soon as a packet arrives, before it is stored in the GoIO Measurement Buffer.
+				*pTimestampNs is the arrival time in nanoseconds on the CLOCK_MONOTONIC clock, see
+				GoIO_Sensor_ReadRawMeasurementsWithTimestamps().
+
+				This routine is currently only supported on Linux.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, -1 if no measurement has been received since the sensor was opened.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_PeekLatestMeasurement(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurement,		//[out] most recent raw measurement.
+	gtype_uint64 *pTimestampNs)	//[out] arrival time of the most recent measurement, may be NULL.
+{
+	gtype_int32 nResult = -1;
+	if ((NULL != pMeasurement) && OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		int nMeasurement;
+		unsigned long long nTimestampNs;
+		if (kResponse_OK == pGoIOSensor->m_pInterface->OSPeekLatestMeasurement(&nMeasurement, &nTimestampNs))
+		{
+			(*pMeasurement) = nMeasurement;
+			if (pTimestampNs)
+				(*pTimestampNs) = nTimestampNs;
+			nResult = 0;
+		}
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_CopyRecentMeasurements()
+	
+	Purpose:	Copy the most recent count measurements received from the sensor, oldest first, without removing
+				anything from the GoIO Measurement Buffer.
+
+				The window ends with the newest measurement received. It includes measurements that have already
+				been read with GoIO_Sensor_ReadRawMeasurements(), as long as the GoIO Measurement Buffer has not
+				reused their space, so it is never longer than the buffer capacity(see GoIO_Sensor_SetMeasurementBufferOptions()).
+				Measurements received before the last call to GoIO_Sensor_ClearIO() are not included.
+
+				This lets a display redraw a sliding window as often as it likes, while another thread reads the full
+				stream.
+
+				pTimestampsBuf may be NULL. Otherwise it receives the arrival time of each measurement, see
+				GoIO_Sensor_ReadRawMeasurementsWithTimestamps().
+
+				This routine is currently only supported on Linux.
+
+				Added in version 2.55.
+	
+	Return:		number of measurements copied, which is less than count if fewer measurements are available.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_CopyRecentMeasurements(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurementsBuf,	//[out] ptr to loc to store measurements.
+	gtype_uint64 *pTimestampsBuf,	//[out] ptr to loc to store arrival times in nanoseconds, may be NULL.
+	gtype_int32 count)	//[in] maximum number of measurements to copy.
+{
+	gtype_int32 nResult = 0;
+	if ((NULL != pMeasurementsBuf) && (count > 0) && OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
+		int nNumMeasurements = count;
+		if (kResponse_OK == pGoIOSensor->m_pInterface->OSCopyRecentMeasurements(pMeasurementsBuf, pTimestampsBuf, &nNumMeasurements))
+			nResult = nNumMeasurements;
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+// Drain up to maxCount measurements and calibrate them. The raw measurements are read into a chunk on the stack. Go! Link
+// and Go! Temp measurements are then looked up in the sensor's calibration table, Go! Motion measurements are converted
+// and calibrated with the block routines.
+template <class T> static gtype_int32 ReadCalibratedMeasurements(
+	CGoIOSensor *pGoIOSensor,
+	T *pMeasurementsBuf,
+	gtype_int32 maxCount)
+{
+	const int kChunkSize = 256;
+	int raw[kChunkSize];
+	real values[kChunkSize];
+	EProbeType eProbeType = pGoIOSensor->m_pMBLSensor->GetProbeType();
+	const real *pTable = pGoIOSensor->m_pInterface->GetCalibrationTable(pGoIOSensor->m_pMBLSensor);
+	gtype_int32 nResult = 0;
+
+	while (nResult < maxCount)
+	{
+		int nNumWanted = maxCount - nResult;
+		if (nNumWanted > kChunkSize)
+			nNumWanted = kChunkSize;
+		int nNumRead = pGoIOSensor->m_pInterface->ReadRawMeasurementsInto(raw, nNumWanted);
+		if (nNumRead <= 0)
+			break;
+
+		int i;
+		if (pTable)
+		{
+			for (i = 0; i < nNumRead; i++)
+				pMeasurementsBuf[nResult + i] = (T) pTable[raw[i] + GMBL_CALIBRATION_TABLE_OFFSET];
+		}
+		else
+		{
+			pGoIOSensor->m_pInterface->ConvertToVoltages(raw, values, nNumRead, eProbeType);
+			pGoIOSensor->m_pMBLSensor->CalibrateData(values, nNumRead);
+			for (i = 0; i < nNumRead; i++)
+				pMeasurementsBuf[nResult + i] = (T) values[i];
+		}
+		nResult += nNumRead;
+
+		if (nNumRead < nNumWanted)
+			break;
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadCalibratedMeasurements()
+	
+	Purpose:	Retrieve measurements from the GoIO Measurement Buffer, already converted to sensor specific units.
+				The measurements reported by this routine are removed from the GoIO Measurement Buffer.
+
+				This gives the same values as calling GoIO_Sensor_ReadRawMeasurements(), and then
+				GoIO_Sensor_ConvertToVoltage() and GoIO_Sensor_CalibrateData() for each measurement, but the sensor
+				is looked up and locked once for the whole block, and the probe type, ADC correction and active
+				calibration page are resolved once per block instead of once per measurement. On cpus with AVX2,
+				Steinhart-Hart and modified power calibrations are computed with vector kernels, so those values may
+				differ slightly from GoIO_Sensor_CalibrateData(). Steinhart-Hart temperatures differ by at most about
+				2.3e-13 degrees. Near 0 C or 0 F this may be many units in the last place of the value. Modified power
+				values y = A*B^v differ by at most (3 + |v*ln(B)|) units in the last place.
+
+				For Go! Link and Go! Temp, whose raw measurements are 16 bit, the first call builds a table of the
+				calibrated value for every possible raw measurement, and later calls just look the measurements up.
+				The table is rebuilt after the calibration changes, e.g. after GoIO_Sensor_DDSMem_SetCalPage(),
+				GoIO_Sensor_DDSMem_SetActiveCalPage(), GoIO_Sensor_DDSMem_SetCalibrationEquation() or
+				GoIO_Sensor_DDSMem_SetRecord().
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer. This routine
+				returns immediately, so the return value may be less than maxCount.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadCalibratedMeasurements(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_real64 *pMeasurementsBuf,	//[out] ptr to loc to store calibrated measurements.
+	gtype_int32 maxCount)			//[in] maximum number of measurements to copy to pMeasurementsBuf.
+{
+	gtype_int32 nResult = 0;
+	if ((NULL != pMeasurementsBuf) && (maxCount > 0) && OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		nResult = ReadCalibratedMeasurements((CGoIOSensor *) hSensor, pMeasurementsBuf, maxCount);
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadCalibratedMeasurementsFloat()
+	
+	Purpose:	Same as GoIO_Sensor_ReadCalibratedMeasurements(), but store single precision values.
+				The calculation is done in double precision, only the result is rounded.
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadCalibratedMeasurementsFloat(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_real32 *pMeasurementsBuf,	//[out] ptr to loc to store calibrated measurements.
+	gtype_int32 maxCount)			//[in] maximum number of measurements to copy to pMeasurementsBuf.
+{
+	gtype_int32 nResult = 0;
+	if ((NULL != pMeasurementsBuf) && (maxCount > 0) && OpenSensorVector_FindAndLockSensor(hSensor))
+	{
+		nResult = ReadCalibratedMeasurements((CGoIOSensor *) hSensor, pMeasurementsBuf, maxCount);
+
+		UnlockSensor(hSensor);
+	}
+
+	return nResult;
+}
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_ConvertToVoltage()
 	
@@ -1524,6 +2708,10 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_DDSMem_WriteRecord(
 
 		if (0 == nResult)
 		{
+			//The copy of the old record in the device record cache is stale now.
+			if (IsValidDeviceSerialNumber(pGoIOSensor->m_deviceSerialNumber))
+				DeviceRecordCache_RemoveDevice(pGoIOSensor->m_pInterface->GetProductID(), pGoIOSensor->m_deviceSerialNumber);
+
 			//Update checksum.
 			pGoIOSensor->m_pMBLSensor->GetDDSRecPtr()->Checksum = 
 				GMBLSensor::CalculateDDSDataChecksum(*pGoIOSensor->m_pMBLSensor->GetDDSRecPtr());
@@ -2398,6 +3586,7 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_DDSMem_SetOperationType(
 	{
 		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
 		pGoIOSensor->m_pMBLSensor->GetDDSRecPtr()->OperationType = OperationType;
+		pGoIOSensor->m_pMBLSensor->InvalidateCalibration();
 		UnlockSensor(hSensor);
 	}
 
@@ -2432,6 +3621,7 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_DDSMem_SetCalibrationEquation(
 	{
 		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
 		pGoIOSensor->m_pMBLSensor->GetDDSRecPtr()->CalibrationEquation = CalibrationEquation;
+		pGoIOSensor->m_pMBLSensor->InvalidateCalibration();
 		UnlockSensor(hSensor);
 	}
 
@@ -2568,6 +3758,7 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_DDSMem_SetHighestValidCalPageInd
 	{
 		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
 		pGoIOSensor->m_pMBLSensor->GetDDSRecPtr()->HighestValidCalPageIndex = HighestValidCalPageIndex;
+		pGoIOSensor->m_pMBLSensor->InvalidateCalibration();
 		UnlockSensor(hSensor);
 	}
 
@@ -2602,6 +3793,7 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_DDSMem_SetActiveCalPage(
 	{
 		CGoIOSensor *pGoIOSensor = (CGoIOSensor *) hSensor;
 		pGoIOSensor->m_pMBLSensor->GetDDSRecPtr()->ActiveCalPage = ActiveCalPage;
+		pGoIOSensor->m_pMBLSensor->InvalidateCalibration();
 		UnlockSensor(hSensor);
 	}
 
@@ -2646,6 +3838,7 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_DDSMem_SetCalPage(
 			pCalPage->CalibrationCoefficientB = CalibrationCoefficientB;
 			pCalPage->CalibrationCoefficientC = CalibrationCoefficientC;
 			strncpy(pCalPage->Units, pUnits, sizeof(pCalPage->Units));
+			pGoIOSensor->m_pMBLSensor->InvalidateCalibration();
 		}
 		else
 			nResult = -1;
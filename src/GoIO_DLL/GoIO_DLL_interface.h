@@ -214,6 +214,62 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_GetNthAvailableDeviceName(
 	gtype_int32 productId,	//[in] USB product id
 	gtype_int32 N);			//[in] index into list of known devices, 0 => first device in list.
 
+/***************************************************************************************************************************
+	Function Name: GoIO_SetDeviceNotificationCallback()
+		Added in version 2.55.
+	
+	Purpose:	Register a routine that is called whenever a Go! Link, Go! Temp, Go! Motion, or Vernier Mini GC device 
+				is plugged in(bArrived = 1) or unplugged(bArrived = 0). pDeviceName is the same string that 
+				GoIO_GetNthAvailableDeviceName() reports for the device, and it is only valid for the duration of the call.
+
+				The callback runs on an internal GoIO thread that only delivers these notifications, one at a time and in
+				the order the devices came and went. It may call any GoIO routine except GoIO_Uninit(), including
+				GoIO_Sensor_Open() and GoIO_Sensor_Close(). While it runs, later notifications wait, but data from open
+				sensors keeps arriving. Pass in NULL to stop receiving notifications.
+
+				Once this routine or GoIO_UpdateListOfAvailableDevices() has been called, GoIO keeps its list of attached
+				devices current from the same operating system notifications, so GoIO_UpdateListOfAvailableDevices() no
+				longer needs to rescan the USB bus.
+
+				Currently only supported on Linux builds that use libusb.
+
+	Return:		0 iff successful, else -1.
+
+****************************************************************************************************************************/
+typedef void (*GOIO_DEVICE_NOTIFICATION_CALLBACK)(
+	gtype_int32 vendorId,		//[in] USB vendor id
+	gtype_int32 productId,		//[in] USB product id
+	const char *pDeviceName,	//[in] NULL terminated string that uniquely identifies the device.
+	gtype_bool bArrived,		//[in] 1 => device was plugged in, 0 => device was removed.
+	void *pContext);			//[in] pContext value passed to GoIO_SetDeviceNotificationCallback().
+
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_SetDeviceNotificationCallback(
+	GOIO_DEVICE_NOTIFICATION_CALLBACK pCallback,	//[in] NULL => disable notifications.
+	void *pContext);								//[in] passed back to pCallback.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_SetDeviceRecordCacheFile()
+	
+	Purpose:	Enable or disable the device record cache. The cache is disabled by default.
+
+				Reading a smart sensor's 128 byte DDS record is one of the slower steps in GoIO_Sensor_Open(). When the
+				cache is enabled, GoIO_Sensor_Open() stores a copy of each DDS record that it reads in the specified file.
+				The copy is keyed by the device's serial number(SKIP_CMD_ID_GET_SERIAL_NUMBER) and the sensor id. Later opens,
+				including opens by later processes, read just the sensor's serial number, lot code, and checksum bytes. If those
+				match the cached copy, then the cached record is used instead of reading the whole record again.
+
+				GoIO_Sensor_DDSMem_WriteRecord() removes the device's entries from the cache.
+
+				Call this routine after GoIO_Init() and before opening any sensors. GoIO_Uninit() disables the cache.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_SetDeviceRecordCacheFile(
+	const char *pFilePath);	//[in] NULL terminated path of cache file. NULL => disable the cache.
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_Open()
 	
@@ -260,6 +316,62 @@ GOIO_DLL_INTERFACE_DECL GOIO_SENSOR_HANDLE GoIO_Sensor_Open(
 	gtype_int32 productId,		//[in] USB product id
 	gtype_int32 strictDDSValidationFlag);//[in] insist on exactly valid checksum if 1, else use a more lax validation test.
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_OpenMany()
+	
+	Purpose:	Open several Go! devices at once. Each device goes through the same sequence as GoIO_Sensor_Open(), but
+				the devices are opened concurrently, so bringing up N devices takes about as long as opening the slowest one.
+				SKIP_CMD_ID_INIT alone can take several seconds on a Go! Link, so this is much faster than calling
+				GoIO_Sensor_Open() on each device in turn when a lot of devices are connected.
+
+				Entries that name a device that is already open, or that repeat an earlier entry in the list, fail.
+
+				The thread that calls this routine is the initial owner of all the sensors that are opened.
+
+				Added in version 2.55.
+	
+	Return:		number of sensors successfully opened.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_OpenMany(
+	gtype_int32 numDevices,				//[in] number of entries in each of the arrays.
+	const char *pDeviceNames[],			//[in] NULL terminated strings that uniquely identify the devices. See GoIO_GetNthAvailableDeviceName().
+	const gtype_int32 vendorIds[],		//[in] USB vendor ids
+	const gtype_int32 productIds[],		//[in] USB product ids
+	gtype_int32 strictDDSValidationFlag,//[in] insist on exactly valid checksum if 1, else use a more lax validation test.
+	GOIO_SENSOR_HANDLE hSensorsOut[],	//[out] handle to each open sensor, NULL if that device failed to open.
+	gtype_int32 statusOut[]);			//[out] 0 if the device opened, -2 if its DDS checksum was bad, else -1. May be NULL.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetOpenPhaseTimings()
+	
+	Purpose:	Report how long each phase of GoIO_Sensor_Open() took for the specified sensor. This is useful for
+				finding out why bringing up a device is slow. Phases that did not apply to the device report 0.
+
+				GOIO_OPEN_PHASE_DEVICE_OPEN	- opening the USB device.
+				GOIO_OPEN_PHASE_INIT		- SKIP_CMD_ID_INIT.
+				GOIO_OPEN_PHASE_READ_ID		- reading the Go! Link flash record and SKIP_CMD_ID_GET_SENSOR_ID.
+				GOIO_OPEN_PHASE_READ_DDS	- reading the sensor's DDS record.
+				GOIO_OPEN_PHASE_CONFIGURE	- SKIP_CMD_ID_SET_ANALOG_INPUT_CHANNEL.
+				GOIO_OPEN_PHASE_TOTAL		- all of GoIO_Sensor_Open().
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+#define GOIO_OPEN_PHASE_DEVICE_OPEN 0
+#define GOIO_OPEN_PHASE_INIT 1
+#define GOIO_OPEN_PHASE_READ_ID 2
+#define GOIO_OPEN_PHASE_READ_DDS 3
+#define GOIO_OPEN_PHASE_CONFIGURE 4
+#define GOIO_OPEN_PHASE_TOTAL 5
+#define GOIO_NUM_OPEN_PHASES 6
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetOpenPhaseTimings(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	gtype_int32 *pTimesMs,		//[out] ptr to array of numTimes elapsed times in milliseconds, indexed by GOIO_OPEN_PHASE_*.
+	gtype_int32 numTimes);		//[in] # of elements in pTimesMs. Pass in GOIO_NUM_OPEN_PHASES.
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_Close()
 	
@@ -435,6 +547,68 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetNextResponse(
 	gtype_int32 *pErrRespFlag,	//[out] flag(1 or 0) indicating that the response contains error info. Ptr must NOT be NULL!
 	gtype_int32 nTimeoutMs);	//[in] # of milliseconds to wait before giving up.
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_SendCmdAsync()
+	
+	Purpose:	Send a command to the specified Go! device hardware without waiting for the response. 
+				GoIO_Sensor_SendCmdAsync() returns as soon as the command has been written to the device.
+
+				Call GoIO_Sensor_CheckAsyncCmd() periodically to find out when the response has arrived. Since
+				GoIO_Sensor_CheckAsyncCmd() never blocks, a single thread can keep commands in flight to many sensors at once,
+				eg. by sending SKIP_CMD_ID_SET_LED_STATE to every open sensor and then polling each one until all are complete.
+
+				Only one async command may be outstanding per sensor, so GoIO_Sensor_SendCmdAsync() fails until 
+				GoIO_Sensor_CheckAsyncCmd() has reported the previous one complete. Any other routine that talks to the sensor,
+				eg. GoIO_Sensor_SendCmdAndGetResponse(), GoIO_Sensor_SendCmd(), GoIO_Sensor_GetNextResponse() or 
+				GoIO_Sensor_Close(), first waits up to timeoutMs for the async response. That response is then still reported
+				by the next GoIO_Sensor_CheckAsyncCmd() call. SKIP_CMD_ID_INIT is not supported, use GoIO_Sensor_SendCmdAndGetResponse().
+
+				If pCallback is not NULL, then it is called from inside the GoIO_Sensor_CheckAsyncCmd() call that completes the
+				command, on the thread that called GoIO_Sensor_CheckAsyncCmd(). The sensor is not locked while the callback runs.
+
+				Added in version 2.55.
+	
+	Return:		0 if the command was sent, else -1.
+
+****************************************************************************************************************************/
+typedef void (*GOIO_CMD_COMPLETION_CALLBACK)(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle of sensor that the command was sent to.
+	unsigned char cmd,			//[in] command code passed to GoIO_Sensor_SendCmdAsync().
+	gtype_int32 status,			//[in] 0 if the command succeeded, else -1.
+	void *pRespBuf,				//[in] response payload. Only valid during the callback.
+	gtype_int32 nRespBytes,		//[in] # of bytes in (*pRespBuf).
+	unsigned char lastCmdStatus,//[in] same as pLastCmdStatus reported by GoIO_Sensor_GetLastCmdResponseStatus().
+	unsigned char lastErrorSentOvertheWire,//[in] same as pLastErrorSentOvertheWire reported by GoIO_Sensor_GetLastCmdResponseStatus().
+	void *pContext);			//[in] pContext value passed to GoIO_Sensor_SendCmdAsync().
+
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_SendCmdAsync(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	unsigned char cmd,			//[in] command code. See SKIP_CMD_ID_* in GSkipCommExt.h.
+	void *pParams,				//[in] ptr to cmd specific parameter block, may be NULL. See GSkipCommExt.h.
+	gtype_int32 nParamBytes,	//[in] # of bytes in (*pParams).
+	gtype_int32 timeoutMs,		//[in] # of milliseconds to wait for a reply before GoIO_Sensor_CheckAsyncCmd() gives up.
+	GOIO_CMD_COMPLETION_CALLBACK pCallback,//[in] called when the command completes, may be NULL.
+	void *pContext);				//[in] passed back to pCallback.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_CheckAsyncCmd()
+	
+	Purpose:	Check whether the command sent by GoIO_Sensor_SendCmdAsync() has completed. This routine does not block.
+
+				When the command completes, the response is copied to pRespBuf and the completion callback passed to
+				GoIO_Sensor_SendCmdAsync() is invoked, if there is one. After that, GoIO_Sensor_GetLastCmdResponseStatus()
+				reports the status of the async command just as it would for GoIO_Sensor_SendCmdAndGetResponse().
+
+				Added in version 2.55.
+	
+	Return:		1 if the command is still pending, 0 if it completed successfully, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_CheckAsyncCmd(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	void *pRespBuf,				//[out] ptr to destination buffer, may be NULL. See GSkipCommExt.h.
+	gtype_int32 *pnRespBytes);	//[in, out] ptr to size of of pRespBuf buffer on input, size of response on output, may be NULL if pRespBuf is NULL.
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_GetMeasurementTickInSeconds()
 	
@@ -547,6 +721,8 @@ GOIO_DLL_INTERFACE_DECL gtype_real64 GoIO_Sensor_GetMeasurementPeriod(
 				often enough so that the GoIO_Sensor_GetNumMeasurementsAvailable() does not reach 1200.
 				On the other hand, we reserve the right to make the Measurement Buffer > 1200 measurements, so
 				do not assume that you can empty the buffer simply by reading in 1200 measurements.
+				On Linux, GoIO_Sensor_SetMeasurementBufferOptions() makes the buffer larger and selects what happens
+				when it is full.
 
 				Each of the following actions clears the GoIO Measurement Buffer:
 					1) Call GoIO_Sensor_ReadRawMeasurements() with count set to GoIO_Sensor_GetNumMeasurementsAvailable(), or
@@ -566,6 +742,102 @@ GOIO_DLL_INTERFACE_DECL gtype_real64 GoIO_Sensor_GetMeasurementPeriod(
 GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetNumMeasurementsAvailable(
 	GOIO_SENSOR_HANDLE hSensor);//[in] handle to open sensor.
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_SetMeasurementBufferOptions()
+	
+	Purpose:	Resize the GoIO Measurement Buffer of the specified sensor and choose what happens when it overflows.
+				By default the buffer holds 6000 measurements and drops the oldest measurement when it is full.
+
+				capacity is the number of measurements the buffer holds. Measurements already in the buffer are
+				kept, newest first, as far as they fit.
+
+				overflowPolicy is one of:
+				GOIO_MEAS_BUFFER_OVERFLOW_DROP_OLDEST	- discard the oldest measurement in the buffer to make room.
+				GOIO_MEAS_BUFFER_OVERFLOW_DROP_NEWEST	- discard the measurement that just arrived.
+				GOIO_MEAS_BUFFER_OVERFLOW_BLOCK			- stop reading packets from this sensor when the buffer is nearly full,
+														  so they back up in the USB stack, until the application reads
+														  measurements or blockTimeoutMs passes. After the timeout the oldest
+														  measurement is discarded until the application catches up.
+														  Other sensors are not held up while this sensor waits.
+
+				blockTimeoutMs is ignored unless overflowPolicy is GOIO_MEAS_BUFFER_OVERFLOW_BLOCK.
+
+				Every discarded measurement is counted, see GoIO_Sensor_GetMeasurementBufferOverflowCount().
+
+				This routine is currently only supported on Linux.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+#define GOIO_MEAS_BUFFER_OVERFLOW_DROP_OLDEST 0
+#define GOIO_MEAS_BUFFER_OVERFLOW_DROP_NEWEST 1
+#define GOIO_MEAS_BUFFER_OVERFLOW_BLOCK 2
+#define GOIO_MIN_MEAS_BUFFER_CAPACITY 16
+#define GOIO_MAX_MEAS_BUFFER_CAPACITY 4194304
+#define GOIO_MAX_MEAS_BUFFER_BLOCK_TIMEOUT_MS 1000
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_SetMeasurementBufferOptions(
+	GOIO_SENSOR_HANDLE hSensor,	//[in] handle to open sensor.
+	gtype_int32 capacity,		//[in] GOIO_MIN_MEAS_BUFFER_CAPACITY to GOIO_MAX_MEAS_BUFFER_CAPACITY measurements.
+	gtype_int32 overflowPolicy,	//[in] GOIO_MEAS_BUFFER_OVERFLOW_*
+	gtype_int32 blockTimeoutMs);	//[in] 0 to GOIO_MAX_MEAS_BUFFER_BLOCK_TIMEOUT_MS.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetMeasurementBufferOverflowCount()
+	
+	Purpose:	Report how many measurements the GoIO Measurement Buffer of the specified sensor has discarded
+				because it was full, since the sensor was opened.
+				GoIO_Sensor_ClearIO() does not reset the count.
+
+				This routine is currently only supported on Linux.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetMeasurementBufferOverflowCount(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_uint32 *pOverflowCount);	//[out] # of measurements discarded.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetStreamIntegrity()
+	
+	Purpose:	Report whether the measurements read from the specified sensor form a complete stream.
+
+				Every measurement packet carries a rolling counter, so each measurement has an 8 bit sequence number.
+				As measurements are read by GoIO_Sensor_ReadRawMeasurements() or GoIO_Sensor_GetLatestRawMeasurement(),
+				breaks in the sequence are recorded as gaps. A gap covers packets lost between the sensor and the host
+				as well as measurements discarded by a full GoIO Measurement Buffer(see GoIO_Sensor_SetMeasurementBufferOptions()).
+				Measurements discarded by GoIO_Sensor_ClearIO() are not counted, and neither is the time between
+				SKIP_CMD_ID_STOP_MEASUREMENTS and the next SKIP_CMD_ID_START_MEASUREMENTS.
+
+				Because the sequence number is only 8 bits, a single gap of 256 or more measurements is under reported
+				by a multiple of 256. GoIO_Sensor_GetMeasurementBufferOverflowCount() reports buffer overflows exactly.
+
+				The most recent GOIO_MAX_STREAM_GAPS_RECORDED gaps are kept. Each gap is reported as the number of
+				measurements read before the gap(its position in the stream) and the number of measurements missing.
+				The lost packet count is an estimate, based on the number of measurements per packet.
+
+				All counts start at 0 when the sensor is opened.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, else -1.
+
+****************************************************************************************************************************/
+#define GOIO_MAX_STREAM_GAPS_RECORDED 64
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetStreamIntegrity(
+	GOIO_SENSOR_HANDLE hSensor,				//[in] handle to open sensor.
+	gtype_uint64 *pNumMeasurementsRead,		//[out] # of measurements read since the sensor was opened.
+	gtype_uint64 *pNumLostPackets,			//[out] estimated # of measurement packets lost.
+	gtype_uint64 *pNumLostMeasurements,		//[out] # of measurements lost.
+	gtype_uint32 *pNumGaps,					//[out] # of gaps since the sensor was opened.
+	gtype_uint64 *pGapPositions,			//[out] ptr to array of *pIONumGaps stream positions, oldest gap first. May be NULL.
+	gtype_uint32 *pGapNumMissing,			//[out] ptr to array of *pIONumGaps measurement counts. May be NULL.
+	gtype_int32 *pIONumGaps);	//[in, out] size of the gap arrays on input, # of gaps copied on output. May be NULL.
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_ReadRawMeasurements()
 	
@@ -606,6 +878,87 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadRawMeasurements(
 	gtype_int32 *pMeasurementsBuf,	//[out] ptr to loc to store measurements.
 	gtype_int32 maxCount);	//[in] maximum number of measurements to copy to pMeasurementsBuf. See warning above.
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadRawMeasurementsWithTimestamps()
+	
+	Purpose:	Same as GoIO_Sensor_ReadRawMeasurements(), but also report when each measurement arrived.
+
+				pTimestampsBuf[i] is the time at which the packet carrying pMeasurementsBuf[i] was received by the
+				host, in nanoseconds on the CLOCK_MONOTONIC clock(see clock_gettime()). Measurements that came in the
+				same packet have the same timestamp. The timestamps measure when the packet reached the application
+				side of the USB stack, so they include bus and scheduling latency.
+
+				Arrival times are currently only recorded on Linux. On other platforms the timestamps are 0.
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer. This routine
+				returns immediately, so the return value may be less than maxCount.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadRawMeasurementsWithTimestamps(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurementsBuf,	//[out] ptr to loc to store measurements.
+	gtype_uint64 *pTimestampsBuf,	//[out] ptr to loc to store arrival times in nanoseconds.
+	gtype_int32 maxCount);	//[in] maximum number of measurements to copy to pMeasurementsBuf and pTimestampsBuf.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadRawMeasurementsWithEstimatedTimes()
+	
+	Purpose:	Same as GoIO_Sensor_ReadRawMeasurements(), but also report when each measurement was taken, in nanoseconds
+				on the host CLOCK_MONOTONIC clock.
+
+				The sensor takes measurements on its own clock, which drifts relative to the host clock. The times reported
+				here come from a per sensor timeline estimator that fits the arrival times of the packets against the
+				position of each measurement in the stream(including lost measurements, see GoIO_Sensor_GetStreamIntegrity()),
+				using the measurement period as the starting point. Unlike the raw arrival times reported by 
+				GoIO_Sensor_ReadRawMeasurementsWithTimestamps(), consecutive estimated times are evenly spaced, and times from
+				different sensors can be compared directly. The estimate is aligned with the average arrival time, so it
+				includes the average USB latency.
+
+				The estimator restarts whenever SKIP_CMD_ID_SET_MEASUREMENT_PERIOD or SKIP_CMD_ID_START_MEASUREMENTS succeeds, and
+				after GoIO_Sensor_ClearIO(). It does not run until the measurement period has been set with 
+				GoIO_Sensor_SetMeasurementPeriod() after the sensor was opened. Times are 0 until the estimator has an arrival
+				time to work from. See GoIO_Sensor_GetTimelineEstimate().
+
+				Arrival times are currently only recorded on Linux. On other platforms the estimated times are 0.
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer. This routine
+				returns immediately, so the return value may be less than maxCount.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadRawMeasurementsWithEstimatedTimes(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurementsBuf,	//[out] ptr to loc to store measurements.
+	gtype_uint64 *pTimesBuf,		//[out] ptr to loc to store estimated measurement times in nanoseconds.
+	gtype_int32 maxCount);	//[in] maximum number of measurements to copy to pMeasurementsBuf and pTimesBuf.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_GetTimelineEstimate()
+	
+	Purpose:	Report the state of the timeline estimator used by GoIO_Sensor_ReadRawMeasurementsWithEstimatedTimes().
+
+				*pPeriodInSeconds is the measurement period as measured by the host clock.
+				*pDriftPpm is how much faster(positive) or slower(negative) the sensor clock runs than the host clock,
+				in parts per million.
+				*pJitterInSeconds is the rms deviation of the packet arrival times from the fitted timeline.
+				*pNumPoints is the number of arrival times the estimate is based on. Every arrival counts equally, so the
+				estimate keeps improving during a long capture.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, -1 if there is no estimate yet(fewer than 2 arrival times since the estimator restarted).
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetTimelineEstimate(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_real64 *pPeriodInSeconds,	//[out]
+	gtype_real64 *pDriftPpm,		//[out]
+	gtype_real64 *pJitterInSeconds,	//[out]
+	gtype_uint32 *pNumPoints);	//[out]
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_GetLatestRawMeasurement()
 	
@@ -635,6 +988,110 @@ GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadRawMeasurements(
 GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_GetLatestRawMeasurement(
 	GOIO_SENSOR_HANDLE hSensor);//[in] handle to open sensor.
 
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_PeekLatestMeasurement()
+	
+	Purpose:	Report the most recent measurement received from the sensor, and when it arrived, without removing
+				anything from the GoIO Measurement Buffer.
+
+				Unlike GoIO_Sensor_GetLatestRawMeasurement(), this routine does not empty the GoIO Measurement Buffer,
+				and it takes the same short time however many measurements are waiting. So one thread can poll the
+				current value while another thread reads the full stream with GoIO_Sensor_ReadRawMeasurements().
+
+				The value is updated as soon as a packet arrives, before it is stored in the GoIO Measurement Buffer.
+				*pTimestampNs is the arrival time in nanoseconds on the CLOCK_MONOTONIC clock, see
+				GoIO_Sensor_ReadRawMeasurementsWithTimestamps().
+
+				This routine is currently only supported on Linux.
+
+				Added in version 2.55.
+	
+	Return:		0 if successful, -1 if no measurement has been received since the sensor was opened.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_PeekLatestMeasurement(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurement,		//[out] most recent raw measurement.
+	gtype_uint64 *pTimestampNs);	//[out] arrival time of the most recent measurement, may be NULL.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_CopyRecentMeasurements()
+	
+	Purpose:	Copy the most recent count measurements received from the sensor, oldest first, without removing
+				anything from the GoIO Measurement Buffer.
+
+				The window ends with the newest measurement received. It includes measurements that have already
+				been read with GoIO_Sensor_ReadRawMeasurements(), as long as the GoIO Measurement Buffer has not
+				reused their space, so it is never longer than the buffer capacity(see GoIO_Sensor_SetMeasurementBufferOptions()).
+				Measurements received before the last call to GoIO_Sensor_ClearIO() are not included.
+
+				This lets a display redraw a sliding window as often as it likes, while another thread reads the full
+				stream.
+
+				pTimestampsBuf may be NULL. Otherwise it receives the arrival time of each measurement, see
+				GoIO_Sensor_ReadRawMeasurementsWithTimestamps().
+
+				This routine is currently only supported on Linux.
+
+				Added in version 2.55.
+	
+	Return:		number of measurements copied, which is less than count if fewer measurements are available.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_CopyRecentMeasurements(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_int32 *pMeasurementsBuf,	//[out] ptr to loc to store measurements.
+	gtype_uint64 *pTimestampsBuf,	//[out] ptr to loc to store arrival times in nanoseconds, may be NULL.
+	gtype_int32 count);	//[in] maximum number of measurements to copy.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadCalibratedMeasurements()
+	
+	Purpose:	Retrieve measurements from the GoIO Measurement Buffer, already converted to sensor specific units.
+				The measurements reported by this routine are removed from the GoIO Measurement Buffer.
+
+				This gives the same values as calling GoIO_Sensor_ReadRawMeasurements(), and then
+				GoIO_Sensor_ConvertToVoltage() and GoIO_Sensor_CalibrateData() for each measurement, but the sensor
+				is looked up and locked once for the whole block, and the probe type, ADC correction and active
+				calibration page are resolved once per block instead of once per measurement. On cpus with AVX2,
+				Steinhart-Hart and modified power calibrations are computed with vector kernels, so those values may
+				differ slightly from GoIO_Sensor_CalibrateData(). Steinhart-Hart temperatures differ by at most about
+				2.3e-13 degrees. Near 0 C or 0 F this may be many units in the last place of the value. Modified power
+				values y = A*B^v differ by at most (3 + |v*ln(B)|) units in the last place.
+
+				For Go! Link and Go! Temp, whose raw measurements are 16 bit, the first call builds a table of the
+				calibrated value for every possible raw measurement, and later calls just look the measurements up.
+				The table is rebuilt after the calibration changes, e.g. after GoIO_Sensor_DDSMem_SetCalPage(),
+				GoIO_Sensor_DDSMem_SetActiveCalPage(), GoIO_Sensor_DDSMem_SetCalibrationEquation() or
+				GoIO_Sensor_DDSMem_SetRecord().
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer. This routine
+				returns immediately, so the return value may be less than maxCount.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadCalibratedMeasurements(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_real64 *pMeasurementsBuf,	//[out] ptr to loc to store calibrated measurements.
+	gtype_int32 maxCount);	//[in] maximum number of measurements to copy to pMeasurementsBuf.
+
+/***************************************************************************************************************************
+	Function Name: GoIO_Sensor_ReadCalibratedMeasurementsFloat()
+	
+	Purpose:	Same as GoIO_Sensor_ReadCalibratedMeasurements(), but store single precision values.
+				The calculation is done in double precision, only the result is rounded.
+
+				Added in version 2.55.
+
+	Return:		number of measurements retrieved from the GoIO Measurement Buffer.
+
+****************************************************************************************************************************/
+GOIO_DLL_INTERFACE_DECL gtype_int32 GoIO_Sensor_ReadCalibratedMeasurementsFloat(
+	GOIO_SENSOR_HANDLE hSensor,		//[in] handle to open sensor.
+	gtype_real32 *pMeasurementsBuf,	//[out] ptr to loc to store calibrated measurements.
+	gtype_int32 maxCount);	//[in] maximum number of measurements to copy to pMeasurementsBuf.
+
 /***************************************************************************************************************************
 	Function Name: GoIO_Sensor_ConvertToVoltage()
 	
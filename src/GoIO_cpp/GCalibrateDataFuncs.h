@@ -58,6 +58,42 @@ namespace LIB_NAMESPACE {
 		double coeffA,
 		double coeffB);
 
+	// Array versions of the routines above. Each one calibrates pData[0..nCount-1] in place. The Linear and Quadratic
+	// versions give exactly the same results as calling the single sample routine on each element. On cpus with AVX2
+	// and FMA, the SteinhartHart and ModifiedPower versions use vector log() and exp() kernels instead of the C library,
+	// so their results differ slightly from the single sample routine. SteinhartHart is within about 2.3*10^-13 degrees
+	// in every unit. Near 0 C or 0 F that absolute error is many ulp of the returned value. ModifiedPower is within
+	// (3 + |v*ln(coeffB)|) ulp. See GCalibrateDataFuncs.cpp for how these were measured. Build with
+	// CALIBRATE_DATA_NO_AVX2 defined to get bit identical results from those too.
+	void CalibrateDataArray_Linear(
+		double *pData,
+		int nCount,
+		double coeffA,
+		double coeffB);
+
+	void CalibrateDataArray_SteinhartHart(
+		double *pData,
+		int nCount,
+		double coeffA,
+		double coeffB,
+		double coeffC,
+		double resistance,
+		double maxVolts,
+		char unit);
+
+	void CalibrateDataArray_Quadratic(
+		double *pData,
+		int nCount,
+		double coeffA,
+		double coeffB,
+		double coeffC);
+
+	void CalibrateDataArray_ModifiedPower(
+		double *pData,
+		int nCount,
+		double coeffA,
+		double coeffB);
+
 #ifdef LIB_NAMESPACE
 }
 #endif
@@ -45,8 +45,6 @@ static char THIS_FILE[] = __FILE__;
 namespace LIB_NAMESPACE {
 #endif
 
-#define NUM_PACKETS_IN_RETRIEVAL_BUFFER 20
-
 real GCyclopsDevice::k_fCyclopsMaxDeltaT = 180000*0.001;
 #ifdef OPUS_LITE
 real GCyclopsDevice::k_fCyclopsMinDeltaT = 0.04;
@@ -64,95 +62,27 @@ GCyclopsDevice::GCyclopsDevice(GPortRef *pPortRef)
 		GUtils::Trace(GSTD_S("Error - GCyclopsDevice constructor, OSInitialize() returned false."));
 }
 
-intVector GCyclopsDevice::ReadRawMeasurements(int desiredCount /*=-1*/) // Optional -- can limit the number that will be returned
-{
-	intVector result;
-	int count = desiredCount;
-	GCyclopsMeasurementPacket packets[NUM_PACKETS_IN_RETRIEVAL_BUFFER];
-
-	if (LockDevice(1) && IsOKToUse())
-	{ // Make sure we're the only thread that has acces to this device
-		int nNumMeasurementsInVec = 0;
-		int nNumPacketsJustRead, nNumPacketsToAskFor;
-		int measurement;
-		if (count < 0)
-			count = MeasurementsAvailable();
-		while (nNumMeasurementsInVec < count)
-		{
-			unsigned char nNumMeasurementsInLastPacket;
-			nNumPacketsToAskFor = OSMeasurementPacketsAvailable(&nNumMeasurementsInLastPacket);
-			if ((nNumMeasurementsInVec + nNumPacketsToAskFor*nNumMeasurementsInLastPacket) > count)
-				nNumPacketsToAskFor = (count - nNumMeasurementsInVec)/nNumMeasurementsInLastPacket;
-			if (0 == nNumPacketsToAskFor)
-				break;
-
-			nNumPacketsJustRead = nNumPacketsToAskFor;
-			OSReadMeasurementPackets(&packets, &nNumPacketsJustRead, NUM_PACKETS_IN_RETRIEVAL_BUFFER);
-
-			if (0 == nNumPacketsJustRead)
-				break;
-			else
-			{
-				int nPacket;
-				for (nPacket = 0; nPacket < nNumPacketsJustRead; nPacket++)
-				{
-                    GCyclopsMeasurementPacket *pPacket = &packets[nPacket];
-					GUtils::OSConvertBytesToInt(pPacket->measLsByteLsWord, pPacket->measMsByteLsWord, 
-                        pPacket->measLsByteMsWord, pPacket->measMsByteMsWord, &measurement);
-					result.push_back(measurement);
-					nNumMeasurementsInVec++;
-				}
-			}
-		}
-
-		if ((desiredCount > 0) && (count > desiredCount))
-			GSTD_TRACE( GSTD_S("ReadRawMeasurements() is returning more measurements than were asked for."));
-
-		UnlockDevice();
-	}
-	else
-		GSTD_ASSERT(0);
-
-	if (result.size() > 0)
-		m_nLatestRawMeasurement = result[result.size() - 1];
-
-	return result;
-}
-
-int GCyclopsDevice::SendCmdAndGetResponse(
+void GCyclopsDevice::OnCmdSucceeded(
 	unsigned char cmd,	//[in] command code
 	void *pParams,		//[in] ptr to cmd specific parameter block, may be NULL.
-	int nParamBytes,	//[in] # of bytes in (*pParams).
-	void *pRespBuf,		//[out] ptr to destination buffer, may be NULL.
-	int *pnRespBytes,  //[in, out] size of of dest buffer on input, size of response on output, may be NULL if pRespBuf is NULL.
-	int nTimeoutMs /* = 1000 */,//[in] # of milliseconds to wait before giving up.
-	bool *pExitFlag /* = NULL */)//[in] ptr to flag that another thread can set to force early exit. 
-						//		THIS FLAG MUST BE FALSE FOR THIS ROUTINE TO RUN.
-						//		Ignore this if NULL.
+	int nParamBytes)	//[in] # of bytes in (*pParams).
 {
-	int nResult = TBaseClass::SendCmdAndGetResponse(cmd, pParams, nParamBytes, pRespBuf, pnRespBytes, nTimeoutMs, pExitFlag);
-
-    if (kResponse_OK == nResult)
-    {
-		//Keep track if we are starting measurements.
-	    if (SKIP_CMD_ID_START_MEASUREMENTS == cmd) //Check for STOP in SendCmd().
+	//Keep track if we are starting measurements.
+	if (SKIP_CMD_ID_START_MEASUREMENTS == cmd) //Check for STOP in SendCmd().
+	{
+		if (!pParams)
+			m_bIsMeasuring = true;
+		else
 		{
-			if (!pParams)
+			GSTD_ASSERT(sizeof(GCyclopsStartMeasurementsParams) == nParamBytes);
+			GCyclopsStartMeasurementsParams *pCyclopsParams = static_cast<GCyclopsStartMeasurementsParams *>(pParams);
+			if ((0 == pCyclopsParams->lsbyteMeasurementCount) && (0 == pCyclopsParams->msbyteMeasurementCount))
 				m_bIsMeasuring = true;
 			else
-			{
-				GSTD_ASSERT(sizeof(GCyclopsStartMeasurementsParams) == nParamBytes);
-				GCyclopsStartMeasurementsParams *pCyclopsParams = static_cast<GCyclopsStartMeasurementsParams *>(pParams);
-				if ((0 == pCyclopsParams->lsbyteMeasurementCount) && (0 == pCyclopsParams->msbyteMeasurementCount))
-					m_bIsMeasuring = true;
-				else
-					m_bIsMeasuring = false;//We are starting non real time measurements. This ends eventually - we will
-										   //pretend that it has stopped already.
-			}
+				m_bIsMeasuring = false;//We are starting non real time measurements. This ends eventually - we will
+									   //pretend that it has stopped already.
 		}
-    }
-
-	return nResult;
+	}
 }
 
 int GCyclopsDevice::ReadSensorDDSMemory(
@@ -56,15 +56,13 @@ public:
 	static void			StoreSnapshotOfAvailableDevices(const StringVector &devices) { m_snapshotOfAvailableDevices = devices; }
 	static const StringVector &	GetSnapshotOfAvailableDevices(void) { return m_snapshotOfAvailableDevices; }
 
-	virtual int		SendCmdAndGetResponse(unsigned char cmd, void *pParams, int nParamBytes, void *pRespBuf, int *pnRespBytes, 
-							int nTimeoutMs = 1000, bool *pExitFlag = NULL);
-
 	virtual	int		ReadSensorDDSMemory(unsigned char * /*pBuf*/, unsigned int /*ddsAddr*/, unsigned int /*nBytesToRead*/, 
 							int nTimeoutMs = 1000, bool *pExitFlag = NULL);
 	virtual	int		WriteSensorDDSMemory(unsigned char * /*pBuf*/, unsigned int /*ddsAddr*/, unsigned int /*nBytesToWrites*/,
 							int nTimeoutMs = 1000, bool *pExitFlag = NULL) { nTimeoutMs = 1; pExitFlag = NULL; return -1; }
 
-	virtual intVector	ReadRawMeasurements(int count = -1);
+	virtual MeasurementPacketBatchDecoderPtr GetMeasurementPacketBatchDecoder(void) { return DecodeCyclopsMeasurementPackets; }
+	virtual bool		HasShortRawMeasurements() { return false; }
 
 	static real k_fCyclopsMaxDeltaT; //Const Min and max delta T
 	static real k_fCyclopsMinDeltaT;
@@ -77,6 +75,9 @@ public:
 
 	static size_t k_nMaxRemotePoints;
 
+protected:
+	virtual void		OnCmdSucceeded(unsigned char cmd, void *pParams, int nParamBytes);
+
 private:
 	typedef GSkipBaseDevice TBaseClass;
 
@@ -62,6 +62,10 @@ namespace LIB_NAMESPACE {
 
 GMBLSensor::GMBLSensor(void)
 {
+	m_bResolvedCalibrationValid = false;
+	m_pCalibrationTable = NULL;
+	m_bCalibrationTableValid = false;
+	m_nCalibrationTableConversionVersion = 0;
 	memset(&m_sensorDDSRec, 0, sizeof(m_sensorDDSRec));
 	m_sensorDDSRec.MinSamplePeriod = (float) 0.001;
 	m_sensorDDSRec.TypSamplePeriod = (float) 0.001;
@@ -84,6 +88,8 @@ GMBLSensor::GMBLSensor(void)
 
 GMBLSensor::~GMBLSensor()
 {
+	if (m_pCalibrationTable)
+		delete [] m_pCalibrationTable;
 }
 	
 unsigned char GMBLSensor::CalculateDDSDataChecksum(const GSensorDDSRec &DDSRec)
@@ -369,6 +375,104 @@ real GMBLSensor::CalibrateData(real fRawVolts)
 	return fCalibratedMeasurement;
 }
 
+real *GMBLSensor::StartCalibrationTable()
+{
+	m_bCalibrationTableValid = false;
+	if (!m_pCalibrationTable)
+		m_pCalibrationTable = new real[GMBL_CALIBRATION_TABLE_SIZE];
+
+	return m_pCalibrationTable;
+}
+
+void GMBLSensor::FinishCalibrationTable(unsigned int nConversionVersion)
+{
+	CalibrateData(m_pCalibrationTable, GMBL_CALIBRATION_TABLE_SIZE);
+	m_nCalibrationTableConversionVersion = nConversionVersion;
+	m_bCalibrationTableValid = true;
+}
+
+// One calibrator per equation type. Equations that CalibrateData() does not handle report volts.
+template <int nEquationType> struct GCalibrator
+{
+	static void CalibrateBlock(const GResolvedCalibration & /*cal*/, real * /*pData*/, int /*nCount*/) {}
+};
+
+template <> struct GCalibrator<kEquationType_Linear>
+{
+	static void CalibrateBlock(const GResolvedCalibration &cal, real *pData, int nCount)
+	{
+		CalibrateDataArray_Linear(pData, nCount, cal.coeffA, cal.coeffB);
+	}
+};
+
+template <> struct GCalibrator<kEquationType_Quadratic>
+{
+	static void CalibrateBlock(const GResolvedCalibration &cal, real *pData, int nCount)
+	{
+		CalibrateDataArray_Quadratic(pData, nCount, cal.coeffA, cal.coeffB, cal.coeffC);
+	}
+};
+
+template <> struct GCalibrator<kEquationType_ModifiedPower>
+{
+	static void CalibrateBlock(const GResolvedCalibration &cal, real *pData, int nCount)
+	{
+		CalibrateDataArray_ModifiedPower(pData, nCount, cal.coeffA, cal.coeffB);
+	}
+};
+
+template <> struct GCalibrator<kEquationType_SteinhartHart>
+{
+	static void CalibrateBlock(const GResolvedCalibration &cal, real *pData, int nCount)
+	{
+		CalibrateDataArray_SteinhartHart(pData, nCount, cal.coeffA, cal.coeffB, cal.coeffC, 15000.0, 5.0, cal.unit);
+	}
+};
+
+void GMBLSensor::ResolveCalibration()
+{
+	int nPage = m_sensorDDSRec.ActiveCalPage;
+	if (nPage > m_sensorDDSRec.HighestValidCalPageIndex)
+		nPage = 0;
+	const GCalibrationPage *pActiveCalibration = &(m_sensorDDSRec.CalibrationPage[nPage]);
+	m_resolvedCalibration.coeffA = pActiveCalibration->CalibrationCoefficientA;
+	m_resolvedCalibration.coeffB = pActiveCalibration->CalibrationCoefficientB;
+	m_resolvedCalibration.coeffC = pActiveCalibration->CalibrationCoefficientC;
+	m_resolvedCalibration.unit = pActiveCalibration->Units[0];
+	if ('(' == m_resolvedCalibration.unit)
+		m_resolvedCalibration.unit = pActiveCalibration->Units[1];
+
+	switch (m_sensorDDSRec.CalibrationEquation)
+	{
+		case kEquationType_Linear:
+			m_resolvedCalibration.pCalibrateBlock = GCalibrator<kEquationType_Linear>::CalibrateBlock;
+			break;
+		case kEquationType_Quadratic:
+			m_resolvedCalibration.pCalibrateBlock = GCalibrator<kEquationType_Quadratic>::CalibrateBlock;
+			break;
+		case kEquationType_ModifiedPower:
+			m_resolvedCalibration.pCalibrateBlock = GCalibrator<kEquationType_ModifiedPower>::CalibrateBlock;
+			break;
+		case kEquationType_SteinhartHart:
+			m_resolvedCalibration.pCalibrateBlock = GCalibrator<kEquationType_SteinhartHart>::CalibrateBlock;
+			break;
+		default:
+			m_resolvedCalibration.pCalibrateBlock = GCalibrator<kEquationType_None>::CalibrateBlock;
+			break;
+	}
+
+	m_bResolvedCalibrationValid = true;
+}
+
+void GMBLSensor::CalibrateData(
+	real *pData,	//[in,out] voltages in, calibrated measurements out.
+	int nCount)
+{
+	if (!m_bResolvedCalibrationValid)
+		ResolveCalibration();
+	m_resolvedCalibration.pCalibrateBlock(m_resolvedCalibration, pData, nCount);
+}
+
 #ifdef LIB_NAMESPACE
 }
 #endif
@@ -42,6 +42,22 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace LIB_NAMESPACE {
 #endif
 
+// The calibration table has one entry for each 16 bit raw measurement. Entry (raw + GMBL_CALIBRATION_TABLE_OFFSET) holds
+// the calibrated value for raw.
+#define GMBL_CALIBRATION_TABLE_SIZE 65536
+#define GMBL_CALIBRATION_TABLE_OFFSET 32768
+
+// The active calibration page and equation, resolved from the DDS record once so blocks of measurements can be calibrated
+// without looking them up again. pCalibrateBlock is one of the GCalibrator<> instances in GMBLSensor.cpp.
+struct GResolvedCalibration
+{
+	real		coeffA;
+	real		coeffB;
+	real		coeffC;
+	char		unit;		// Steinhart-Hart only.
+	void		(*pCalibrateBlock)(const GResolvedCalibration &cal, real *pData, int nCount);
+};
+
 class GMBLSensor
 {
 public:
@@ -56,6 +72,7 @@ public:
 									UnMarshallDDSRec(&m_sensorDDSRec, rec);
 								else
 									m_sensorDDSRec = rec;
+								InvalidateCalibration();
 							}
 	void					GetDDSRec(GSensorDDSRec *pRec)
 							{
@@ -78,6 +95,7 @@ public:
 									id = 0;
 								if (id != m_sensorDDSRec.SensorNumber)
 								{
+									InvalidateCalibration();
 									if (0 == id)
 										m_sensorDDSRec.SensorNumber = 0;//Leave the rest of the record alone.
 									else if (id >= kSensorIdNumber_FirstSmartSensor)
@@ -115,6 +133,27 @@ public:
 	cppstring				GetUnits(void);
 
 	real					CalibrateData(real fRawVolts);
+	// Calibrate a block of voltages in place. The active page and the equation are resolved once, and kept until
+	// InvalidateCalibration().
+	void					CalibrateData(real *pData, int nCount);
+
+	// Lookup table from raw measurement to calibrated value, built by GSkipBaseDevice::GetCalibrationTable().
+	// GetCalibrationTable() returns NULL until the table is built, after InvalidateCalibration(), or if nConversionVersion
+	// differs from the one the table was built with.
+	const real				*GetCalibrationTable(unsigned int nConversionVersion)
+							{
+								return (m_bCalibrationTableValid && (nConversionVersion == m_nCalibrationTableConversionVersion)) ?
+									m_pCalibrationTable : NULL;
+							}
+	real					*StartCalibrationTable();	// Caller fills the table with volts, then calls FinishCalibrationTable().
+	void					FinishCalibrationTable(unsigned int nConversionVersion);
+	// Drop the resolved calibration and the calibration table. Anyone who changes the calibration fields or the
+	// OperationType through GetDDSRecPtr() must call this.
+	void					InvalidateCalibration()
+							{
+								m_bResolvedCalibrationValid = false;
+								m_bCalibrationTableValid = false;
+							}
 
 	
 	// DDS burning/reading methods
@@ -122,7 +161,14 @@ public:
 	static bool				VerifyDDSChecksum(const GSensorDDSRec &rec, bool bStrictChecksumRequired);
 	
 private:
+	void					ResolveCalibration();
+
 	GSensorDDSRec			m_sensorDDSRec;
+	GResolvedCalibration	m_resolvedCalibration;
+	bool					m_bResolvedCalibrationValid;
+	real					*m_pCalibrationTable;	// GMBL_CALIBRATION_TABLE_SIZE entries, allocated on first use.
+	bool					m_bCalibrationTableValid;
+	unsigned int			m_nCalibrationTableConversionVersion;
 };
 
 #ifdef LIB_NAMESPACE
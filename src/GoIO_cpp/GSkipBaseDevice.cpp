@@ -34,6 +34,19 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GUtils.h"
 
+#include <string.h>
+
+//Measurement packets are little endian. On little endian hosts the batch decoders copy the samples straight out of the
+//packets. The host byte order is decided here at compile time, anything not known to be little endian uses the shifts.
+#if defined(_WIN32) || defined(__LITTLE_ENDIAN__) || (defined(TARGET_RT_LITTLE_ENDIAN) && TARGET_RT_LITTLE_ENDIAN) || \
+	(defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+#define SKIP_HOST_IS_LITTLE_ENDIAN
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define SKIP_DECODE_USE_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
 #ifdef _DEBUG
 #include "GPlatformDebug.h" // for DEBUG_NEW definition
 #undef THIS_FILE
@@ -49,8 +62,6 @@ real GSkipBaseDevice::kVoltsOffset_ProbeTypeAnalog5V = 2.5;
 real GSkipBaseDevice::kVoltsPerBit_ProbeTypeAnalog10V = 10.0/0x8000;
 real GSkipBaseDevice::kVoltsOffset_ProbeTypeAnalog10V = 0.0;
 
-#define NUM_PACKETS_IN_RETRIEVAL_BUFFER 25
-
 #define DIAGNOSTIC_IO_BUFFER_SIZE 10000
 
 /*******************************************************************************
@@ -60,6 +71,14 @@ GSkipBaseDevice::GSkipBaseDevice(GPortRef *pPortRef)
 : TBaseClass(pPortRef)
 {
 	m_nLatestRawMeasurement = 0;
+	m_nVoltageConversionVersion = 0;
+	m_bExpectedSequenceNumberValid = false;
+	m_nExpectedSequenceNumber = 0;
+	m_nNumMeasurementsRead = 0;
+	m_nNumLostPackets = 0;
+	m_nNumLostMeasurements = 0;
+	m_nNumStreamGaps = 0;
+	m_nStreamIndex = 0;
     m_bIsMeasuring = false;
 	m_hostIOStatus = 0;
 	m_lastCmd = 0;
@@ -70,6 +89,16 @@ GSkipBaseDevice::GSkipBaseDevice(GPortRef *pPortRef)
 	m_diagnosticInputBufferPtr = NULL;
 	m_diagnosticOutputBufferPtr = NULL;
 	m_pTraceQueueAccessMutex = NULL;
+	m_bAsyncCmdPending = false;
+	m_asyncCmd = 0;
+	m_nAsyncCmdParamBytes = 0;
+	m_nAsyncCmdStartTime = 0;
+	m_nAsyncCmdTimeoutMs = 0;
+	m_bAsyncCmdDone = false;
+	m_nAsyncCmdResult = kResponse_Error;
+	m_nAsyncCmdRespBytes = 0;
+	m_asyncCmdRespStatus = 0;
+	m_asyncErrorSentOvertheWire = 0;
 }
 
 GSkipBaseDevice::~GSkipBaseDevice()
@@ -147,77 +176,441 @@ int GSkipBaseDevice::MeasurementsAvailable(void)
 intVector GSkipBaseDevice::ReadRawMeasurements(int desiredCount /*=-1*/) // Optional -- can limit the number that will be returned
 {
 	intVector result;
-	int count = desiredCount;
-	GSkipMeasurementPacket packets[NUM_PACKETS_IN_RETRIEVAL_BUFFER];
+	int count = MeasurementsAvailable();
+	if ((desiredCount >= 0) && (desiredCount < count))
+		count = desiredCount;
+
+	if (count > 0)
+	{
+		result.resize(count);
+		result.resize(ReadRawMeasurementsInto(&result[0], count));
+	}
+
+	return result;
+}
+
+int GSkipBaseDevice::ReadRawMeasurementsInto(
+	int *pMeasurements,	//[out] ptr to loc to store measurements.
+	int maxCount,		//[in] maximum number of measurements to copy to pMeasurements.
+	unsigned long long *pTimestampsNs /* = NULL */,		//[out] ptr to loc to store arrival times, may be NULL.
+	unsigned long long *pEstimatedTimesNs /* = NULL */)	//[out] ptr to loc to store estimated measurement times, may be NULL.
+{
+	int nNumMeasurementsRead = 0;
 
 	if (LockDevice(1) && IsOKToUse())
 	{ // Make sure we're the only thread that has acces to this device
-		int nNumMeasurementsInVec = 0;
-		int nNumPacketsJustRead, nNumPacketsToAskFor;
-		int measurement;
-		if (count < 0)
-			count = MeasurementsAvailable();
-		while (nNumMeasurementsInVec < count)
+		int count = MeasurementsAvailable();
+		if (count > maxCount)
+			count = maxCount;
+
+		//The Linux backends queue measurements that the listener has already decoded, so they are just copied out.
+		unsigned char nNumMeasurementsInLastPacket = 1;
+		if ((int) m_sequenceNumberRetrievalBuffer.size() < count)
+			m_sequenceNumberRetrievalBuffer.resize(count);
+		//The arrival times also feed the timeline estimator, so they are fetched even if the caller does not want them.
+		unsigned long long *pArrivalTimesNs = pTimestampsNs;
+		if ((NULL == pArrivalTimesNs) && (count > 0))
 		{
-			unsigned char nNumMeasurementsInLastPacket;
-			nNumPacketsToAskFor = OSMeasurementPacketsAvailable(&nNumMeasurementsInLastPacket);
-			if ((nNumMeasurementsInVec + nNumPacketsToAskFor*nNumMeasurementsInLastPacket) > count)
-				nNumPacketsToAskFor = (count - nNumMeasurementsInVec)/nNumMeasurementsInLastPacket;
-			if (0 == nNumPacketsToAskFor)
-				break;
-
-			nNumPacketsJustRead = nNumPacketsToAskFor;
-			OSReadMeasurementPackets(&packets, &nNumPacketsJustRead, NUM_PACKETS_IN_RETRIEVAL_BUFFER);
-
-			if (0 == nNumPacketsJustRead)
-				break;
-			else
+			if ((int) m_timestampRetrievalBuffer.size() < count)
+				m_timestampRetrievalBuffer.resize(count);
+			pArrivalTimesNs = &m_timestampRetrievalBuffer[0];
+		}
+		nNumMeasurementsRead = count;
+		if (kResponse_OK == OSReadMeasurements((count > 0) ? pMeasurements : NULL, (count > 0) ? &m_sequenceNumberRetrievalBuffer[0] : NULL,
+				(count > 0) ? pArrivalTimesNs : NULL, &nNumMeasurementsRead, count, &nNumMeasurementsInLastPacket))
+			TrackMeasurementSequence((count > 0) ? &m_sequenceNumberRetrievalBuffer[0] : NULL, pArrivalTimesNs, nNumMeasurementsRead, 
+				nNumMeasurementsInLastPacket, pEstimatedTimesNs);
+		else
+		{
+			//Otherwise the queue holds raw packets. They are decoded straight into pMeasurements, and the
+			//retrieval buffer is kept between calls so that steady state reads do not allocate.
+			MeasurementPacketBatchDecoderPtr pDecoder = GetMeasurementPacketBatchDecoder();
+			nNumMeasurementsRead = 0;
+			while (nNumMeasurementsRead < count)
 			{
-				int nPacket;
-				for (nPacket = 0; nPacket < nNumPacketsJustRead; nPacket++)
+				unsigned char nNumMeasurementsInLastPacket;
+				int nNumPacketsToAskFor = OSMeasurementPacketsAvailable(&nNumMeasurementsInLastPacket);
+				if (0 == nNumMeasurementsInLastPacket)
+					break;
+				if ((nNumMeasurementsRead + nNumPacketsToAskFor*nNumMeasurementsInLastPacket) > count)
+					nNumPacketsToAskFor = (count - nNumMeasurementsRead)/nNumMeasurementsInLastPacket;
+				if (0 == nNumPacketsToAskFor)
+					break;
+
+				if ((int) m_measurementPacketRetrievalBuffer.size() < nNumPacketsToAskFor)
+					m_measurementPacketRetrievalBuffer.resize(nNumPacketsToAskFor);
+				int nNumPacketsJustRead = nNumPacketsToAskFor;
+				OSReadMeasurementPackets(&m_measurementPacketRetrievalBuffer[0], &nNumPacketsJustRead, 
+					(int) m_measurementPacketRetrievalBuffer.size());
+				if (0 == nNumPacketsJustRead)
+					break;
+
+				for (int nPacket = 0; nPacket < nNumPacketsJustRead; nPacket++)
 				{
-					unsigned char nMeasInPacket = 0;
-					unsigned char *pMeasInPacket = &packets[nPacket].meas0LsByte;
-					while (nMeasInPacket < packets[nPacket].nMeasurementsInPacket) //Return all the measurements in the packet.
+					int measurements[SKIP_MAX_MEASUREMENTS_IN_PACKET];
+					unsigned char sequenceNumbers[SKIP_MAX_MEASUREMENTS_IN_PACKET];
+					int nNumInPacket;
+					int nMeasInPacket = pDecoder(&m_measurementPacketRetrievalBuffer[nPacket], 1, measurements, sequenceNumbers, &nNumInPacket);
+					if (nMeasInPacket > (maxCount - nNumMeasurementsRead))
+					{
+						GSTD_TRACE(GSTD_S("ReadRawMeasurementsInto() is discarding measurements that do not fit in the caller's buffer."));
+						nMeasInPacket = maxCount - nNumMeasurementsRead;
+					}
+					for (int i = 0; i < nMeasInPacket; i++)
 					{
-						short shortMeas;
-						GUtils::OSConvertBytesToShort(pMeasInPacket[0], pMeasInPacket[1], &shortMeas);
-						measurement = shortMeas;
-						result.push_back(measurement);
-						nNumMeasurementsInVec++;
-						nMeasInPacket++;
-						pMeasInPacket += 2;
+						if (pTimestampsNs)
+							pTimestampsNs[nNumMeasurementsRead] = 0;//Arrival times are not recorded on this platform.
+						pMeasurements[nNumMeasurementsRead++] = measurements[i];
 					}
+					TrackMeasurementSequence(sequenceNumbers, NULL, nMeasInPacket, nNumInPacket, 
+						pEstimatedTimesNs ? &pEstimatedTimesNs[nNumMeasurementsRead - nMeasInPacket] : NULL);
 				}
 			}
 		}
 
-		if ((desiredCount > 0) && (count > desiredCount))
-			GSTD_TRACE(GSTD_S("ReadRawMeasurements() is returning more measurements than were asked for."));
+		if (nNumMeasurementsRead > 0)
+			m_nLatestRawMeasurement = pMeasurements[nNumMeasurementsRead - 1];
 
 		UnlockDevice();
 	}
 	else
 		GSTD_ASSERT(0);
 
-	if (result.size() > 0)
-		m_nLatestRawMeasurement = result[result.size() - 1];
+	return nNumMeasurementsRead;
+}
 
-	return result;
+void GSkipBaseDevice::TrackMeasurementSequence(
+	const unsigned char *pSequenceNumbers,	//[in] sequence numbers of the measurements just read.
+	const unsigned long long *pTimestampsNs,//[in] arrival times of the measurements just read, may be NULL.
+	int nNumMeasurements,					//[in] # of entries in pSequenceNumbers.
+	int nNumMeasurementsPerPacket,			//[in] used to estimate how many packets a gap spans.
+	unsigned long long *pEstimatedTimesNs)	//[out] estimated time of each measurement, may be NULL.
+{
+	if (nNumMeasurementsPerPacket < 1)
+		nNumMeasurementsPerPacket = 1;
+
+	for (int i = 0; i < nNumMeasurements; i++)
+	{
+		if (m_bExpectedSequenceNumberValid && (pSequenceNumbers[i] != m_nExpectedSequenceNumber))
+		{
+			//The sequence number is only 8 bits, so a gap of 256 or more measurements is under reported by a multiple of 256.
+			unsigned int nNumMissing = (unsigned char) (pSequenceNumbers[i] - m_nExpectedSequenceNumber);
+			GSkipStreamGap *pGap = &m_streamGaps[m_nNumStreamGaps % SKIP_MAX_STREAM_GAPS_RECORDED];
+			pGap->nPosition = m_nNumMeasurementsRead + i;
+			pGap->nNumMissing = nNumMissing;
+			m_nNumStreamGaps++;
+			m_nNumLostMeasurements += nNumMissing;
+			m_nNumLostPackets += (nNumMissing + nNumMeasurementsPerPacket - 1)/nNumMeasurementsPerPacket;
+			m_nStreamIndex += nNumMissing;
+		}
+		m_nExpectedSequenceNumber = (unsigned char) (pSequenceNumbers[i] + 1);
+		m_bExpectedSequenceNumberValid = true;
+
+		//Measurements that arrived together share an arrival time, which is closest to the time the last of them was
+		//taken. So only that one is given to the timeline estimator.
+		if (pTimestampsNs && (pTimestampsNs[i] != 0) && m_timeline.IsRunning() &&
+			((i == (nNumMeasurements - 1)) || (pTimestampsNs[i + 1] != pTimestampsNs[i])))
+			m_timeline.AddPoint(m_nStreamIndex, pTimestampsNs[i]);
+
+		if (pEstimatedTimesNs)
+			pEstimatedTimesNs[i] = m_nStreamIndex;//Converted below, once the whole batch is in the fit.
+		m_nStreamIndex++;
+	}
+
+	if (pEstimatedTimesNs)
+	{
+		for (int i = 0; i < nNumMeasurements; i++)
+			pEstimatedTimesNs[i] = m_timeline.EstimateTimeNs(pEstimatedTimesNs[i]);
+	}
+
+	m_nNumMeasurementsRead += nNumMeasurements;
+}
+
+void GSkipBaseDevice::ResetTimeline()
+{
+	//The sequence check is rearmed as well, so the first measurement afterwards is stream index 0.
+	m_bExpectedSequenceNumberValid = false;
+	m_nStreamIndex = 0;
+	m_timeline.Reset();
+}
+
+int GSkipBaseDevice::GetTimelineEstimate(
+	real *pPeriodInSeconds,		//[out] measurement period in host seconds.
+	real *pDriftPpm,			//[out] how much faster(+) or slower(-) the device clock runs than the host clock.
+	real *pJitterInSeconds,		//[out] rms deviation of the arrival times from the fit.
+	unsigned int *pNumPoints)	//[out] # of arrival times in the fit.
+{
+	int nResult = kResponse_Error;
+
+	if (LockDevice(1) && IsOKToUse())
+	{
+		if (m_timeline.GetEstimate(pPeriodInSeconds, pDriftPpm, pJitterInSeconds, pNumPoints))
+			nResult = kResponse_OK;
+
+		UnlockDevice();
+	}
+	else
+		GSTD_ASSERT(0);
+
+	return nResult;
+}
+
+int GSkipBaseDevice::GetStreamIntegrity(
+	unsigned long long *pNumMeasurementsRead,	//[out] # of measurements read since the device was opened.
+	unsigned long long *pNumLostPackets,		//[out] estimated # of measurement packets lost since the device was opened.
+	unsigned long long *pNumLostMeasurements,	//[out] # of measurements lost since the device was opened.
+	unsigned int *pNumGaps,						//[out] # of gaps since the device was opened.
+	GSkipStreamGap *pGaps,						//[out] most recent gaps, oldest first. May be NULL if pIONumGaps is NULL.
+	int *pIONumGaps)							//[in, out] size of pGaps on input, # of gaps copied on output. May be NULL.
+{
+	int nResult = kResponse_Error;
+
+	if (LockDevice(1) && IsOKToUse())
+	{
+		(*pNumMeasurementsRead) = m_nNumMeasurementsRead;
+		(*pNumLostPackets) = m_nNumLostPackets;
+		(*pNumLostMeasurements) = m_nNumLostMeasurements;
+		(*pNumGaps) = m_nNumStreamGaps;
+
+		if (pIONumGaps != NULL)
+		{
+			int nNumGapsKept = (m_nNumStreamGaps < SKIP_MAX_STREAM_GAPS_RECORDED) ? m_nNumStreamGaps : SKIP_MAX_STREAM_GAPS_RECORDED;
+			int nNumGapsToCopy = (*pIONumGaps);
+			if (nNumGapsToCopy > nNumGapsKept)
+				nNumGapsToCopy = nNumGapsKept;
+			if (nNumGapsToCopy < 0)
+				nNumGapsToCopy = 0;
+			for (int i = 0; i < nNumGapsToCopy; i++)
+				pGaps[i] = m_streamGaps[(m_nNumStreamGaps - nNumGapsToCopy + i) % SKIP_MAX_STREAM_GAPS_RECORDED];
+			(*pIONumGaps) = nNumGapsToCopy;
+		}
+		nResult = kResponse_OK;
+
+		UnlockDevice();
+	}
+	else
+		GSTD_ASSERT(0);
+
+	return nResult;
+}
+
+int GSkipBaseDevice::ClearIO(void)
+{
+	int nResult = TBaseClass::ClearIO();
+
+	//Measurements discarded on purpose are not lost, but the stream index of the next measurement is unknown.
+	ResetTimeline();
+
+	return nResult;
+}
+
+GSkipTimelineEstimator::GSkipTimelineEstimator()
+{
+	m_fNominalPeriodNs = 0.0;
+	Reset();
+}
+
+void GSkipTimelineEstimator::Reset()
+{
+	m_nOriginIndex = 0;
+	m_nOriginTimeNs = 0;
+	m_nNumPoints = 0;
+	m_fMeanX = m_fMeanY = 0.0;
+	m_fSxx = m_fSxy = m_fSyy = 0.0;
+}
+
+void GSkipTimelineEstimator::SetNominalPeriod(real fPeriodInSeconds)
+{
+	m_fNominalPeriodNs = fPeriodInSeconds*1.0e9;
+	Reset();
+}
+
+void GSkipTimelineEstimator::AddPoint(unsigned long long nStreamIndex, unsigned long long nArrivalTimeNs)
+{
+	if (0 == m_nNumPoints)
+	{
+		m_nOriginIndex = nStreamIndex;
+		m_nOriginTimeNs = nArrivalTimeNs;
+	}
+
+	real x = (real) (long long) (nStreamIndex - m_nOriginIndex);
+	real y = ((real) (long long) (nArrivalTimeNs - m_nOriginTimeNs)) - x*m_fNominalPeriodNs;
+
+	//Welford style update of the means and the centered sums of products.
+	m_nNumPoints++;
+	real dx = x - m_fMeanX;
+	real dy = y - m_fMeanY;
+	m_fMeanX += dx/m_nNumPoints;
+	m_fMeanY += dy/m_nNumPoints;
+	m_fSxx += dx*(x - m_fMeanX);
+	m_fSxy += dx*(y - m_fMeanY);
+	m_fSyy += dy*(y - m_fMeanY);
+}
+
+unsigned long long GSkipTimelineEstimator::EstimateTimeNs(unsigned long long nStreamIndex)
+{
+	if (0 == m_nNumPoints)
+		return 0;
+
+	real fSlope = (m_fSxx > 0.0) ? m_fSxy/m_fSxx : 0.0;
+	real x = (real) (long long) (nStreamIndex - m_nOriginIndex);
+	real fOffsetNs = x*(m_fNominalPeriodNs + fSlope) + (m_fMeanY - fSlope*m_fMeanX);
+	return m_nOriginTimeNs + (unsigned long long) (long long) floor(fOffsetNs + 0.5);
+}
+
+bool GSkipTimelineEstimator::GetEstimate(real *pPeriodInSeconds, real *pDriftPpm, real *pJitterInSeconds, unsigned int *pNumPoints)
+{
+	if ((m_nNumPoints < 2) || (m_fSxx <= 0.0))
+		return false;
+
+	real fSlope = m_fSxy/m_fSxx;
+	(*pPeriodInSeconds) = (m_fNominalPeriodNs + fSlope)*1.0e-9;
+	//A longer period in host time means the device clock is slow.
+	(*pDriftPpm) = -fSlope/m_fNominalPeriodNs*1.0e6;
+	real fResidualSumOfSquares = m_fSyy - fSlope*m_fSxy;
+	if ((m_nNumPoints < 3) || (fResidualSumOfSquares < 0.0))
+		fResidualSumOfSquares = 0.0;
+	(*pJitterInSeconds) = (m_nNumPoints > 2) ? sqrt(fResidualSumOfSquares/(m_nNumPoints - 2))*1.0e-9 : 0.0;
+	(*pNumPoints) = m_nNumPoints;
+
+	return true;
+}
+
+int GSkipBaseDevice::DecodeSkipMeasurementPackets(
+	const GSkipPacket *pPackets,
+	int nNumPackets,
+	int *pMeasurements,			//[out]
+	unsigned char *pSequenceNumbers,	//[out]
+	int *pNumInLastPacket)		//[out]
+{
+	int nNumMeasurements = 0;
+	int nNumInPacket = 0;
+	int nPacket = 0;
+
+#ifdef SKIP_DECODE_USE_SSE2
+	//Widen all three 16 bit slots of a packet to 32 bits with one unpack and one arithmetic shift, store the
+	//4 words starting at the first slot, then advance by the real count so the next packet overwrites the unused
+	//slots. Sequence numbers are stored 4 at a time the same way. Both stores write one entry past the last slot,
+	//so the last packet goes through the scalar code.
+	for (; nPacket < nNumPackets - 1; nPacket++)
+	{
+		const GSkipMeasurementPacket *pMeasPacket = (const GSkipMeasurementPacket *) &pPackets[nPacket];
+		nNumInPacket = pMeasPacket->nMeasurementsInPacket;
+		if (nNumInPacket > SKIP_MAX_MEASUREMENTS_IN_PACKET)
+			nNumInPacket = SKIP_MAX_MEASUREMENTS_IN_PACKET;
+
+		__m128i packet = _mm_loadl_epi64((const __m128i *) pMeasPacket);
+		__m128i words = _mm_srai_epi32(_mm_unpacklo_epi16(packet, packet), 16);
+		_mm_storeu_si128((__m128i *) &pMeasurements[nNumMeasurements], _mm_srli_si128(words, 4));
+
+		unsigned char nRollingCounter = pMeasPacket->nRollingCounter;
+		unsigned char sequenceNumbers[4] = { nRollingCounter, (unsigned char) (nRollingCounter + 1),
+			(unsigned char) (nRollingCounter + 2), (unsigned char) (nRollingCounter + 3) };
+		memcpy(&pSequenceNumbers[nNumMeasurements], sequenceNumbers, sizeof(sequenceNumbers));
+		nNumMeasurements += nNumInPacket;
+	}
+#endif
+
+	for (; nPacket < nNumPackets; nPacket++)
+	{
+		const GSkipMeasurementPacket *pMeasPacket = (const GSkipMeasurementPacket *) &pPackets[nPacket];
+		nNumInPacket = pMeasPacket->nMeasurementsInPacket;
+		if (nNumInPacket > SKIP_MAX_MEASUREMENTS_IN_PACKET)
+			nNumInPacket = SKIP_MAX_MEASUREMENTS_IN_PACKET;
+
+		//Measurements are 16 bit signed values, least significant byte first.
+		const unsigned char *pMeasInPacket = &pMeasPacket->meas0LsByte;
+		for (int i = 0; i < nNumInPacket; i++)
+		{
+#ifdef SKIP_HOST_IS_LITTLE_ENDIAN
+			short meas;
+			memcpy(&meas, pMeasInPacket, sizeof(meas));
+			pMeasurements[nNumMeasurements + i] = meas;
+#else
+			pMeasurements[nNumMeasurements + i] = (short) (pMeasInPacket[0] | (pMeasInPacket[1] << 8));
+#endif
+			pMeasInPacket += 2;
+			pSequenceNumbers[nNumMeasurements + i] = (unsigned char) (pMeasPacket->nRollingCounter + i);
+		}
+		nNumMeasurements += nNumInPacket;
+	}
+
+	(*pNumInLastPacket) = nNumInPacket;
+	return nNumMeasurements;
+}
+
+int GSkipBaseDevice::DecodeCyclopsMeasurementPackets(
+	const GSkipPacket *pPackets,
+	int nNumPackets,
+	int *pMeasurements,			//[out]
+	unsigned char *pSequenceNumbers,	//[out]
+	int *pNumInLastPacket)		//[out]
+{
+	for (int nPacket = 0; nPacket < nNumPackets; nPacket++)
+	{
+		const GCyclopsMeasurementPacket *pMeasPacket = (const GCyclopsMeasurementPacket *) &pPackets[nPacket];
+#ifdef SKIP_HOST_IS_LITTLE_ENDIAN
+		int meas;
+		memcpy(&meas, &pMeasPacket->measLsByteLsWord, sizeof(meas));
+		pMeasurements[nPacket] = meas;
+#else
+		//One 32 bit signed measurement, least significant byte first.
+		pMeasurements[nPacket] = (int) (((unsigned int) pMeasPacket->measLsByteLsWord) | (((unsigned int) pMeasPacket->measMsByteLsWord) << 8) |
+			(((unsigned int) pMeasPacket->measLsByteMsWord) << 16) | (((unsigned int) pMeasPacket->measMsByteMsWord) << 24));
+#endif
+		pSequenceNumbers[nPacket] = pMeasPacket->nRollingCounter;
+	}
+
+	(*pNumInLastPacket) = (nNumPackets > 0) ? 1 : 0;
+	return nNumPackets;
+}
+
+void GSkipBaseDevice::ConvertToVoltages(
+	const int *pRaw,	//[in] raw measurements.
+	real *pVolts,		//[out] voltages.
+	int nCount,
+	EProbeType eProbeType)
+{
+	for (int i = 0; i < nCount; i++)
+		pVolts[i] = ConvertToVoltage(pRaw[i], eProbeType);
+}
+
+const real *GSkipBaseDevice::GetCalibrationTable(GMBLSensor *pSensor)
+{
+	if (!HasShortRawMeasurements())
+		return NULL;
+
+	const real *pTable = pSensor->GetCalibrationTable(m_nVoltageConversionVersion);
+	if (!pTable)
+	{
+		real *pVolts = pSensor->StartCalibrationTable();
+		EProbeType eProbeType = pSensor->GetProbeType();
+		int raw[256];
+		for (int nFirst = 0; nFirst < GMBL_CALIBRATION_TABLE_SIZE; nFirst += 256)
+		{
+			for (int i = 0; i < 256; i++)
+				raw[i] = nFirst + i - GMBL_CALIBRATION_TABLE_OFFSET;
+			ConvertToVoltages(raw, &pVolts[nFirst], 256, eProbeType);
+		}
+		pSensor->FinishCalibrationTable(m_nVoltageConversionVersion);
+		pTable = pVolts;
+	}
+
+	return pTable;
 }
 
 int	GSkipBaseDevice::GetLatestRawMeasurement()
 {
-	intVector vec;
+	int measurements[256];
 	int count = MeasurementsAvailable();
 
 	while (count > 0)
 	{
-		vec = ReadRawMeasurements(200);
-		if (0 == vec.size())
+		int nNumRead = ReadRawMeasurementsInto(measurements, (count < 256) ? count : 256);
+		if (0 == nNumRead)
 			break;
 		else
-			count -= vec.size();
+			count -= nNumRead;
 	}
 
 	return m_nLatestRawMeasurement;
@@ -231,6 +624,9 @@ int GSkipBaseDevice::SendCmd(
 	int nResult;
 	GSkipOutputPacket packet;
 
+	//Otherwise the response to this command would be taken for the async command's response, or vice versa.
+	CompleteAsyncCmd();
+
 	if (SKIP_CMD_ID_START_MEASUREMENTS == cmd)
 		GSTD_ASSERT((0 == MeasurementsAvailable()) || pParams);
     else if ((SKIP_CMD_ID_STOP_MEASUREMENTS == cmd) || (SKIP_CMD_ID_INIT == cmd))
@@ -299,6 +695,8 @@ int GSkipBaseDevice::GetNextResponse(
 		pMyExitFlag = pExitFlag;
 	unsigned char *packetPayload;
 
+	CompleteAsyncCmd();
+
 	unsigned int nStartTime = GUtils::OSGetTimeStamp();
 
 	while (((GUtils::OSGetTimeStamp() - nStartTime) <= ((unsigned int) nTimeoutMs)) &&
@@ -362,7 +760,15 @@ int GSkipBaseDevice::GetNextResponse(
 		}//while
 
 		if ((!bResponseComplete) && (kResponse_OK == nResult))
-			GUtils::Sleep(10);
+		{
+			//Block until the listener queues another response packet, rather than polling.
+			//Wake up at least every 50 ms so that (*pMyExitFlag) is still honored.
+			int nWaitMs = nTimeoutMs - ((int) (GUtils::OSGetTimeStamp() - nStartTime)) + 1;
+			if (nWaitMs > 50)
+				nWaitMs = 50;
+			if (nWaitMs > 0)
+				OSWaitForCmdRespPackets(nWaitMs);
+		}
 	}//while
 
 	if (pnRespBytes)
@@ -434,7 +840,15 @@ int GSkipBaseDevice::GetInitCmdResponse(
 		}//while
 
 		if ((!bResponseComplete) && (kResponse_OK == nResult))
-			GUtils::Sleep(10);
+		{
+			//Block until the listener queues another response packet, rather than polling.
+			//Wake up at least every 50 ms so that (*pMyExitFlag) is still honored.
+			int nWaitMs = nTimeoutMs - ((int) (GUtils::OSGetTimeStamp() - nStartTime)) + 1;
+			if (nWaitMs > 50)
+				nWaitMs = 50;
+			if (nWaitMs > 0)
+				OSWaitForCmdRespPackets(nWaitMs);
+		}
 	}//while
 
 	if (pnRespBytes)
@@ -475,42 +889,68 @@ int GSkipBaseDevice::SendCmdAndGetResponse(
 		nResult = SendCmd(cmd,	pParams, nParamBytes);
 
 		if (kResponse_OK == nResult)
+			nResult = GetCmdResponse(cmd, pRespBuf, pnRespBytes, nTimeoutMs, pExitFlag, &bTimeout);
+
+		UnlockDevice();
+	}
+	else
+		GSTD_ASSERT(0);	// Can't use this device -- some other thread has it open!
+
+	FinishCmd(cmd, pParams, nParamBytes, nResult, bTimeout);
+
+	return nResult;
+}
+
+int GSkipBaseDevice::SendCmdsAndGetResponses(
+	GSkipPipelinedCmd *pCmds,//[in, out] commands to send, in order. Responses and results are stored back in here.
+	int nNumCmds,		//[in] # of entries in pCmds.
+	int nTimeoutMs /* = 1000 */,//[in] # of milliseconds to wait for all the responses before giving up.
+	bool *pExitFlag /* = NULL */)//[in] ptr to flag that another thread can set to force early exit. 
+						//		THIS FLAG MUST BE FALSE FOR THIS ROUTINE TO RUN.
+						//		Ignore this if NULL.
+{
+	int nResult = kResponse_Error;
+	int nNumSent = 0;
+	int i;
+
+	for (i = 0; i < nNumCmds; i++)
+		pCmds[i].nResult = kResponse_Error;
+
+	if (LockDevice(1) && IsOKToUse())
+	{
+		//Put every command on the wire before waiting for any responses. The firmware processes commands in the
+		//order they arrive, and the first packet of each response carries the cmd id, so GetCmdResponse() can
+		//verify that each response matches the command we expect next.
+		nResult = kResponse_OK;
+		for (nNumSent = 0; nNumSent < nNumCmds; nNumSent++)
 		{
-			if (SKIP_CMD_ID_INIT == cmd)
-				nResult = GetInitCmdResponse(pRespBuf,	pnRespBytes, nTimeoutMs, pExitFlag);
-			else
+			//INIT resets the command pipe and START changes what the device sends back, so neither can be pipelined.
+			GSTD_ASSERT((SKIP_CMD_ID_INIT != pCmds[nNumSent].cmd) && (SKIP_CMD_ID_START_MEASUREMENTS != pCmds[nNumSent].cmd));
+			if (kResponse_OK != SendCmd(pCmds[nNumSent].cmd, pCmds[nNumSent].pParams, pCmds[nNumSent].nParamBytes))
 			{
-				unsigned char responseCmd;
-				bool bError;
-				cppsstream ss;
-				nResult = GetNextResponse(pRespBuf,	pnRespBytes, &responseCmd, &bError, nTimeoutMs, pExitFlag);
-				if (kResponse_OK != nResult)
-				{
-					bTimeout = true;
-					m_hostIOStatus = m_hostIOStatus | SKIP_HOST_IO_STATUS_TIMED_OUT;
-					ss << GSTD_S("Error waiting for response to ") << hex << ((unsigned short) cmd) << GSTD_S("h cmd from Skip. Timeout??");
-					GSTD_TRACE(ss.str());
-					if (pnRespBytes)
-						(*pnRespBytes) = 0;//Only 'over the wire' errors have response data.
-				}
-				else
-				if (bError)
-				{
-					ss << GSTD_S("Skip reported an error over the wire. cmd sent = ") << hex << ((unsigned short) cmd) << GSTD_S("h. Error returned = ");
-					ss << ((unsigned short) m_lastErrorSentOvertheWire) << GSTD_S("h.");
-					GSTD_TRACE(ss.str());
-					nResult = kResponse_Error;
-				}
-				else
-				if (cmd != responseCmd)
-				{
-					ss << GSTD_S("Skip reported cmd response mismatch. cmd sent = ") << hex << ((unsigned short) cmd) << GSTD_S("h. cmd returned = ");
-					ss << ((unsigned short) responseCmd) << GSTD_S("h.");
-					GSTD_TRACE(ss.str());
-					nResult = kResponse_Error;
-					if (pnRespBytes)
-						(*pnRespBytes) = 0;//Only 'over the wire' errors have response data.
-				}
+				nResult = kResponse_Error;
+				break;
+			}
+		}
+
+		unsigned int nStartTime = GUtils::OSGetTimeStamp();
+		for (i = 0; i < nNumSent; i++)
+		{
+			bool bTimeout = false;
+			int nRemainingMs = nTimeoutMs - ((int) (GUtils::OSGetTimeStamp() - nStartTime));
+			if (nRemainingMs < 0)
+				nRemainingMs = 0;
+
+			m_lastCmd = pCmds[i].cmd;
+			m_lastCmdRespStatus = 0;
+			pCmds[i].nResult = GetCmdResponse(pCmds[i].cmd, pCmds[i].pRespBuf, &pCmds[i].nRespBytes, nRemainingMs, pExitFlag, &bTimeout);
+			FinishCmd(pCmds[i].cmd, pCmds[i].pParams, pCmds[i].nParamBytes, pCmds[i].nResult, bTimeout);
+
+			if (kResponse_OK != pCmds[i].nResult)
+			{
+				nResult = kResponse_Error;
+				if (bTimeout)
+					break;//Responses to the remaining commands cannot be matched up reliably.
 			}
 		}
 
@@ -519,12 +959,92 @@ int GSkipBaseDevice::SendCmdAndGetResponse(
 	else
 		GSTD_ASSERT(0);	// Can't use this device -- some other thread has it open!
 
+	for (i = 0; i < nNumCmds; i++)
+	{
+		if (kResponse_OK != pCmds[i].nResult)
+			pCmds[i].nRespBytes = 0;
+	}
+
+	if ((kResponse_OK != nResult) && (0 == m_lastCmdRespStatus))
+		m_lastCmdRespStatus = SKIP_STATUS_ERROR_COMMUNICATION;
+
+	return nResult;
+}
+
+int GSkipBaseDevice::GetCmdResponse(
+	unsigned char cmd,	//[in] command code that was sent.
+	void *pRespBuf,		//[out] ptr to destination buffer, may be NULL.
+	int *pnRespBytes,  //[in, out] size of of dest buffer on input, size of response on output, may be NULL if pRespBuf is NULL.
+	int nTimeoutMs,		//[in] # of milliseconds to wait before giving up.
+	bool *pExitFlag,	//[in] ptr to flag that another thread can set to force early exit, may be NULL.
+	bool *pbTimeout)	//[out] set if no valid response arrived.
+{
+	int nResult;
+	(*pbTimeout) = false;
+
+	if (SKIP_CMD_ID_INIT == cmd)
+		nResult = GetInitCmdResponse(pRespBuf,	pnRespBytes, nTimeoutMs, pExitFlag);
+	else
+	{
+		unsigned char responseCmd;
+		bool bError;
+		cppsstream ss;
+		nResult = GetNextResponse(pRespBuf,	pnRespBytes, &responseCmd, &bError, nTimeoutMs, pExitFlag);
+		if (kResponse_OK != nResult)
+		{
+			(*pbTimeout) = true;
+			m_hostIOStatus = m_hostIOStatus | SKIP_HOST_IO_STATUS_TIMED_OUT;
+			ss << GSTD_S("Error waiting for response to ") << hex << ((unsigned short) cmd) << GSTD_S("h cmd from Skip. Timeout??");
+			GSTD_TRACE(ss.str());
+			if (pnRespBytes)
+				(*pnRespBytes) = 0;//Only 'over the wire' errors have response data.
+		}
+		else
+		if (bError)
+		{
+			ss << GSTD_S("Skip reported an error over the wire. cmd sent = ") << hex << ((unsigned short) cmd) << GSTD_S("h. Error returned = ");
+			ss << ((unsigned short) m_lastErrorSentOvertheWire) << GSTD_S("h.");
+			GSTD_TRACE(ss.str());
+			nResult = kResponse_Error;
+		}
+		else
+		if (cmd != responseCmd)
+		{
+			ss << GSTD_S("Skip reported cmd response mismatch. cmd sent = ") << hex << ((unsigned short) cmd) << GSTD_S("h. cmd returned = ");
+			ss << ((unsigned short) responseCmd) << GSTD_S("h.");
+			GSTD_TRACE(ss.str());
+			nResult = kResponse_Error;
+			if (pnRespBytes)
+				(*pnRespBytes) = 0;//Only 'over the wire' errors have response data.
+		}
+	}
+
+	return nResult;
+}
+
+void GSkipBaseDevice::FinishCmd(
+	unsigned char cmd,	//[in] command code that was sent.
+	void *pParams,		//[in] ptr to cmd specific parameter block that was sent, may be NULL.
+	int nParamBytes,	//[in] # of bytes in (*pParams).
+	int nResult,		//[in] result of GetCmdResponse().
+	bool bTimeout)		//[in] set by GetCmdResponse().
+{
     if (kResponse_OK == nResult)
-    {
-		//Keep track if we are starting measurements.
-	    if (SKIP_CMD_ID_START_MEASUREMENTS == cmd) //Check for STOP in SendCmd().
-			m_bIsMeasuring = true;
-    }
+	{
+		if ((SKIP_CMD_ID_SET_MEASUREMENT_PERIOD == cmd) && pParams && (nParamBytes >= (int) sizeof(GSkipSetMeasurementPeriodParams)))
+		{
+			GSkipSetMeasurementPeriodParams *pPeriodParams = static_cast<GSkipSetMeasurementPeriodParams *>(pParams);
+			int nNumTicks;
+			GUtils::OSConvertBytesToInt(pPeriodParams->lsbyteLswordMeasurementPeriod, pPeriodParams->msbyteLswordMeasurementPeriod,
+				pPeriodParams->lsbyteMswordMeasurementPeriod, pPeriodParams->msbyteMswordMeasurementPeriod, &nNumTicks);
+			m_timeline.SetNominalPeriod(GetMeasurementTickInSeconds()*nNumTicks);
+		}
+		else
+		if (SKIP_CMD_ID_START_MEASUREMENTS == cmd)
+			ResetTimeline();
+
+		OnCmdSucceeded(cmd, pParams, nParamBytes);
+	}
 	else
 	if (bTimeout)
 	{
@@ -564,10 +1084,150 @@ int GSkipBaseDevice::SendCmdAndGetResponse(
 
 	if ((kResponse_OK != nResult) && (0 == m_lastCmdRespStatus))
 		m_lastCmdRespStatus = SKIP_STATUS_ERROR_COMMUNICATION;
+}
+
+void GSkipBaseDevice::OnCmdSucceeded(
+	unsigned char cmd,	//[in] command code
+	void * /*pParams*/,	//[in] ptr to cmd specific parameter block, may be NULL.
+	int /*nParamBytes*/)//[in] # of bytes in (*pParams).
+{
+	//Keep track if we are starting measurements.
+	if (SKIP_CMD_ID_START_MEASUREMENTS == cmd) //Check for STOP in SendCmd().
+		m_bIsMeasuring = true;
+}
+
+int GSkipBaseDevice::SendCmdAsync(
+	unsigned char cmd,	//[in] command code
+	void *pParams,		//[in] ptr to cmd specific parameter block, may be NULL.
+	int nParamBytes,	//[in] # of bytes in (*pParams).
+	int nTimeoutMs /* = 1000 */)//[in] # of milliseconds to wait for the response before CheckAsyncCmdResponse() gives up.
+{
+	int nResult = kResponse_Error;
+
+	//INIT has its own retry logic(see GSkipDevice::SendInitCmdAndGetResponse()), so it always goes through SendCmdAndGetResponse().
+	if ((SKIP_CMD_ID_INIT == cmd) || IsAsyncCmdPending() || (nParamBytes < 0) || (nParamBytes > (int) sizeof(m_asyncCmdParams)))
+		return kResponse_Error;
+
+	m_lastCmd = cmd;
+	m_lastCmdRespStatus = 0;
+
+	if (LockDevice(1) && IsOKToUse())
+	{
+		nResult = SendCmd(cmd, pParams, nParamBytes);
+		if (kResponse_OK == nResult)
+		{
+			m_bAsyncCmdPending = true;
+			m_asyncCmd = cmd;
+			m_nAsyncCmdParamBytes = (pParams != NULL) ? nParamBytes : 0;
+			if (m_nAsyncCmdParamBytes > 0)
+				memcpy(m_asyncCmdParams, pParams, m_nAsyncCmdParamBytes);
+			m_nAsyncCmdStartTime = GUtils::OSGetTimeStamp();
+			m_nAsyncCmdTimeoutMs = nTimeoutMs;
+		}
+		else
+			m_lastCmdRespStatus = SKIP_STATUS_ERROR_COMMUNICATION;
+
+		UnlockDevice();
+	}
+	else
+		GSTD_ASSERT(0);	// Can't use this device -- some other thread has it open!
+
+	return nResult;
+}
+
+int GSkipBaseDevice::CheckAsyncCmdResponse(
+	void *pRespBuf,		//[out] ptr to destination buffer, may be NULL.
+	int *pnRespBytes,	//[in, out] size of of dest buffer on input, size of response on output, may be NULL if pRespBuf is NULL.
+	bool *pbComplete)	//[out] false => response has not arrived yet, call again later.
+{
+	int nResult = kResponse_OK;
+	(*pbComplete) = false;
+
+	if (!IsAsyncCmdPending())
+		return kResponse_Error;
+
+	if (LockDevice(1) && IsOKToUse())
+	{
+		//Do not block until the response has started to arrive. The device sends all the packets of a response
+		//back to back, so once the first one is queued GetCmdResponse() only waits briefly for the rest.
+		if (m_bAsyncCmdPending && 
+			((OSCmdRespPacketsAvailable() > 0) || (((int) (GUtils::OSGetTimeStamp() - m_nAsyncCmdStartTime)) > m_nAsyncCmdTimeoutMs)))
+			CompleteAsyncCmd();
+
+		if (m_bAsyncCmdDone)
+		{
+			m_bAsyncCmdDone = false;
+			(*pbComplete) = true;
+			nResult = m_nAsyncCmdResult;
+			int nRespBytes = m_nAsyncCmdRespBytes;
+			if (pnRespBytes)
+			{
+				if (nRespBytes > (*pnRespBytes))
+					nRespBytes = (*pnRespBytes);
+				if (pRespBuf && (nRespBytes > 0))
+					memcpy(pRespBuf, m_asyncCmdResp, nRespBytes);
+				(*pnRespBytes) = nRespBytes;
+			}
+
+			//The async command is the one being reported now, even if other commands went out after it.
+			m_lastCmd = m_asyncCmd;
+			m_lastCmdRespStatus = m_asyncCmdRespStatus;
+		}
+		else
+		if (pnRespBytes)
+			(*pnRespBytes) = 0;
+
+		UnlockDevice();
+	}
+	else
+	{
+		GSTD_ASSERT(0);	// Can't use this device -- some other thread has it open!
+		nResult = kResponse_Error;
+	}
 
 	return nResult;
 }
 
+void GSkipBaseDevice::CompleteAsyncCmd()
+{
+	if (m_bAsyncCmdPending && LockDevice(1) && IsOKToUse())
+	{
+		//Cleared first, since GetCmdResponse() calls back in here through GetNextResponse().
+		m_bAsyncCmdPending = false;
+
+		//Leave the status of any synchronous command that is in progress alone.
+		unsigned char lastCmd = m_lastCmd;
+		unsigned char lastCmdRespStatus = m_lastCmdRespStatus;
+		m_lastCmd = m_asyncCmd;
+		m_lastCmdRespStatus = 0;
+
+		bool bTimeout = false;
+		int nRemainingMs = m_nAsyncCmdTimeoutMs - ((int) (GUtils::OSGetTimeStamp() - m_nAsyncCmdStartTime));
+		if (nRemainingMs < 0)
+			nRemainingMs = 0;
+		m_nAsyncCmdRespBytes = sizeof(m_asyncCmdResp);
+		m_nAsyncCmdResult = GetCmdResponse(m_asyncCmd, m_asyncCmdResp, &m_nAsyncCmdRespBytes, nRemainingMs, NULL, &bTimeout);
+		FinishCmd(m_asyncCmd, (m_nAsyncCmdParamBytes > 0) ? m_asyncCmdParams : NULL, m_nAsyncCmdParamBytes, m_nAsyncCmdResult, bTimeout);
+		m_asyncCmdRespStatus = m_lastCmdRespStatus;
+		m_asyncErrorSentOvertheWire = m_lastErrorSentOvertheWire;
+		m_bAsyncCmdDone = true;
+
+		m_lastCmd = lastCmd;
+		m_lastCmdRespStatus = lastCmdRespStatus;
+		UnlockDevice();
+	}
+}
+
+void GSkipBaseDevice::GetAsyncCmdResponseStatus(
+	unsigned char *pCmd,
+	unsigned char *pCmdStatus,
+	unsigned char *pErrorSentOvertheWire)
+{
+	*pCmd = m_asyncCmd;
+	*pCmdStatus = m_asyncCmdRespStatus;
+	*pErrorSentOvertheWire = m_asyncErrorSentOvertheWire;
+}
+
 void GSkipBaseDevice::GetLastCmdResponseStatus(
 	unsigned char *pLastCmd, 
 	unsigned char *pLastCmdStatus,
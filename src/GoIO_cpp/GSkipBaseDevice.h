@@ -43,10 +43,72 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define SKIP_HOST_IO_STATUS_TIMED_OUT	1
 
+#define SKIP_MAX_MEASUREMENTS_IN_PACKET 3
+
+#define SKIP_MAX_STREAM_GAPS_RECORDED 64
+
+//Size of the buffer that holds an async command's response until CheckAsyncCmdResponse() reports it.
+#define SKIP_MAX_ASYNC_CMD_RESPONSE_BYTES 256
+
 #ifdef LIB_NAMESPACE
 namespace LIB_NAMESPACE {
 #endif
 
+// What the measurement packet queue does with a packet that arrives while the queue is full.
+enum EPacketQueueOverflowPolicy
+{
+	kPacketQueueOverflow_DropOldest = 0,
+	kPacketQueueOverflow_DropNewest,
+	kPacketQueueOverflow_BlockProducer	// Stop reading from the device for up to the block timeout, then drop the oldest packet.
+};
+
+// One entry in the batch passed to GSkipBaseDevice::SendCmdsAndGetResponses().
+struct GSkipPipelinedCmd
+{
+	unsigned char		cmd;
+	void				*pParams;		// may be NULL.
+	int					nParamBytes;
+	void				*pRespBuf;		// may be NULL.
+	int					nRespBytes;		// size of pRespBuf on input, size of response on output.
+	int					nResult;		// kResponse_OK if the response arrived and was valid.
+};
+
+// A break in the measurement sequence numbers, see GSkipBaseDevice::GetStreamIntegrity().
+struct GSkipStreamGap
+{
+	unsigned long long	nPosition;		// # of measurements read before the gap.
+	unsigned int		nNumMissing;	// # of measurements missing, modulo 256.
+};
+
+// Maps the position of a measurement in the stream to the host time at which it was taken.
+// The device takes a measurement every period of its own clock, so host time = t0 + index*period, where the period differs
+// from the nominal one by the drift between the two clocks. Arrival times are fit to that line with an online least squares
+// regression. To keep the sums small the fit is done on the difference from the nominal line.
+class GSkipTimelineEstimator
+{
+public:
+						GSkipTimelineEstimator();
+
+	void				Reset();//Forgets the fit, keeps the nominal period.
+	void				SetNominalPeriod(real fPeriodInSeconds);//Also resets.
+	bool				IsRunning() { return (m_fNominalPeriodNs > 0.0); }
+
+	void				AddPoint(unsigned long long nStreamIndex, unsigned long long nArrivalTimeNs);
+	unsigned long long	EstimateTimeNs(unsigned long long nStreamIndex);//0 if there is no estimate yet.
+	bool				GetEstimate(real *pPeriodInSeconds, real *pDriftPpm, real *pJitterInSeconds, unsigned int *pNumPoints);
+
+private:
+	real				m_fNominalPeriodNs;	// 0 => unknown, no points are taken.
+	unsigned long long	m_nOriginIndex;		// first point, the fit is relative to it.
+	unsigned long long	m_nOriginTimeNs;
+	unsigned int		m_nNumPoints;
+	real				m_fMeanX;			// x = index - m_nOriginIndex
+	real				m_fMeanY;			// y = arrival time - m_nOriginTimeNs - x*m_fNominalPeriodNs
+	real				m_fSxx;
+	real				m_fSxy;
+	real				m_fSyy;
+};
+
 class GSkipBaseDevice : public GDeviceIO
 {
 public:
@@ -74,11 +136,24 @@ public:
 
 	int					OSMeasurementPacketsAvailable(unsigned char *pNumMeasurementsInLastPacket = NULL);
 	int					OSCmdRespPacketsAvailable(void);
+	int					OSWaitForCmdRespPackets(int nTimeoutMs);//Blocks until a cmd response packet is queued or nTimeoutMs passes.
 
 	int 				OSClearIO(void);
 	int					OSClearMeasurementPacketQueue();
 	int					OSClearCmdRespPacketQueue();
 
+	// Only the Linux backends implement these, the other platforms return kResponse_Error.
+	// The Linux listener decodes measurement packets as they arrive, so its queue holds measurements rather than packets.
+	// OSMeasurementPacketsAvailable() then reports measurements with 1 measurement per packet, and OSReadMeasurementPackets() is not used.
+	int					OSReadMeasurements(int *pMeasurements, unsigned char *pSequenceNumbers, unsigned long long *pTimestampsNs,
+							int *pIONumMeasurements, int nBufferSizeInMeasurements, unsigned char *pNumMeasurementsInLastPacket);
+	int					OSSetMeasurementQueueOptions(int nCapacity, int nOverflowPolicy, int nBlockTimeoutMs);
+	int					OSGetMeasurementQueueOverflowCount(unsigned int *pNumDropped);
+	// Most recent measurement received and when it arrived, read without touching the measurement queue.
+	int					OSPeekLatestMeasurement(int *pMeasurement, unsigned long long *pTimestampNs);
+	// Copies the newest measurements, oldest first, without removing them from the measurement queue.
+	int					OSCopyRecentMeasurements(int *pMeasurements, unsigned long long *pTimestampsNs, int *pIONumMeasurements);
+
 	int 				OSBytesAvailable(void); //not used - will assert!
 	int 				OSRead(void * /*pBuffer*/, int * /*pIONumBytes*/, int /*nBufferSize*/); //not used - will assert!
 	int 				OSWrite(void * /*pBuffer*/, int * /*pIONumBytes*/); //not used - will assert!
@@ -91,6 +166,20 @@ public:
 	virtual int			SendCmdAndGetResponse(unsigned char cmd, void *pParams, int nParamBytes, void *pRespBuf, int *pnRespBytes, 
 							int nTimeoutMs = 1000, bool *pExitFlag = NULL);
 
+	// Send all the commands back to back, then collect the responses in order. Saves a round trip per command
+	// when a sequence of independent commands(eg. reads) has to be sent. nTimeoutMs applies to the whole batch.
+	int					SendCmdsAndGetResponses(GSkipPipelinedCmd *pCmds, int nNumCmds, int nTimeoutMs = 1000, bool *pExitFlag = NULL);
+
+	// Split phase commands: SendCmdAsync() returns as soon as the command is on the wire, then CheckAsyncCmdResponse()
+	// is polled until (*pbComplete) is set. Only one async command may be pending per device, and SKIP_CMD_ID_INIT is
+	// not supported. Any other command sent meanwhile first waits for the async response(see CompleteAsyncCmd()),
+	// which CheckAsyncCmdResponse() then reports as usual.
+	int					SendCmdAsync(unsigned char cmd, void *pParams, int nParamBytes, int nTimeoutMs = 1000);
+	int					CheckAsyncCmdResponse(void *pRespBuf, int *pnRespBytes, bool *pbComplete);
+	bool				IsAsyncCmdPending(void) { return m_bAsyncCmdPending || m_bAsyncCmdDone; }
+	// Status of the async command that CheckAsyncCmdResponse() last reported complete.
+	void				GetAsyncCmdResponseStatus(unsigned char *pCmd, unsigned char *pCmdStatus, unsigned char *pErrorSentOvertheWire);
+
 	void				GetLastCmdResponseStatus(unsigned char *pLastCmd, unsigned char *pLastCmdStatus,
 							unsigned char *pLastCmdWithErrorRespSentOvertheWire, unsigned char *pLastErrorSentOvertheWire);
 
@@ -116,14 +205,53 @@ public:
 	virtual real		GetMaximumMeasurementPeriodInSeconds(void) = 0;
 
 	int					MeasurementsAvailable(void);
-	virtual intVector	ReadRawMeasurements(int count = -1);
+	intVector			ReadRawMeasurements(int count = -1);
+	// Copies up to maxCount measurements straight into pMeasurements, returns how many were copied.
+	// pTimestampsNs, if not NULL, receives the CLOCK_MONOTONIC time in nanoseconds at which the listener received each
+	// measurement. Only the Linux backends record it, elsewhere the timestamps are 0.
+	// pEstimatedTimesNs, if not NULL, receives the time each measurement was taken according to the timeline estimator.
+	int					ReadRawMeasurementsInto(int *pMeasurements, int maxCount, unsigned long long *pTimestampsNs = NULL,
+							unsigned long long *pEstimatedTimesNs = NULL);
+
+	// Unpacks a run of measurement packets into one contiguous array, returns the number of measurements.
+	// This is the only measurement decoder, callers that handle one packet at a time pass nNumPackets == 1.
+	// pMeasurements and pSequenceNumbers must have room for nNumPackets*SKIP_MAX_MEASUREMENTS_IN_PACKET entries.
+	// *pNumInLastPacket is set to the number of measurements in the last packet.
+	typedef int (*MeasurementPacketBatchDecoderPtr)(const GSkipPacket *pPackets, int nNumPackets, int *pMeasurements,
+							unsigned char *pSequenceNumbers, int *pNumInLastPacket);
+	virtual MeasurementPacketBatchDecoderPtr GetMeasurementPacketBatchDecoder(void) { return DecodeSkipMeasurementPackets; }
+	static int			DecodeSkipMeasurementPackets(const GSkipPacket *pPackets, int nNumPackets, int *pMeasurements,
+							unsigned char *pSequenceNumbers, int *pNumInLastPacket);
+	static int			DecodeCyclopsMeasurementPackets(const GSkipPacket *pPackets, int nNumPackets, int *pMeasurements,
+							unsigned char *pSequenceNumbers, int *pNumInLastPacket);
     bool                AreMeasurementsEnabled() { return m_bIsMeasuring; }
 
 	int					GetLatestRawMeasurement(void);
 
+	// Every measurement carries a sequence number: the nRollingCounter of its packet plus its index in the packet.
+	// Breaks in the sequence are counted as the measurements are read, so they cover packets lost on the wire as well as
+	// measurements discarded by a full measurement queue. Only the most recent SKIP_MAX_STREAM_GAPS_RECORDED gaps are kept.
+	int					GetStreamIntegrity(unsigned long long *pNumMeasurementsRead, unsigned long long *pNumLostPackets,
+							unsigned long long *pNumLostMeasurements, unsigned int *pNumGaps, GSkipStreamGap *pGaps, int *pIONumGaps);
+	virtual int			ClearIO(void);
+
+	// Host timeline of the measurement stream, fit from the arrival times. Only available where arrival times are recorded(Linux),
+	// and only once the measurement period has been set with SKIP_CMD_ID_SET_MEASUREMENT_PERIOD.
+	int					GetTimelineEstimate(real *pPeriodInSeconds, real *pDriftPpm, real *pJitterInSeconds, unsigned int *pNumPoints);
+
 	unsigned int		GetHostIOStatus() { return m_hostIOStatus;}
 
 	virtual real		ConvertToVoltage(int raw, EProbeType eProbeType, bool bCalibrateADCReading = true) = 0;
+	// Block version of ConvertToVoltage(). The default just calls ConvertToVoltage() for each measurement, devices that
+	// correct the ADC reading override it so the correction is looked up once per block.
+	virtual void		ConvertToVoltages(const int *pRaw, real *pVolts, int nCount, EProbeType eProbeType);
+	// Bumped whenever ConvertToVoltage() starts giving different answers, e.g. a new flash record.
+	unsigned int		GetVoltageConversionVersion() { return m_nVoltageConversionVersion; }
+	// True if raw measurements are 16 bit signed values. Devices with wider measurements override it.
+	virtual bool		HasShortRawMeasurements() { return true; }
+	// Raw to calibrated lookup table for pSensor, built on first use and kept by pSensor until the calibration changes.
+	// Returns NULL if the raw measurements are not 16 bit.
+	const real			*GetCalibrationTable(GMBLSensor *pSensor);
 
 	void				SetDiagnosticsFlag(bool bFlag) { m_bDiagnosticsEnabled = bFlag; }
 	bool				GetDiagnosticsFlag() { return m_bDiagnosticsEnabled; }
@@ -132,8 +260,20 @@ public:
 
 	static StringVector OSGetAvailableDevicesOfType(int nVendorID, int nProductID);
 
+	// Optional notification when a Vernier device arrives or leaves. Only the libusb backend implements this,
+	// OSSetDeviceNotificationCallback() returns kResponse_Error on the other platforms.
+	typedef void (*DeviceNotificationFunctionPtr)(int nVendorID, int nProductID, const cppstring &sDeviceName, bool bArrived, void *pContext);
+	static int			OSSetDeviceNotificationCallback(DeviceNotificationFunctionPtr pFunction, void *pContext);
+	static void			OSReleaseDeviceRegistry(void);
+
 protected:
 	virtual int			GetInitCmdResponse(void *pRespBuf, int *pnRespBytes, int nTimeoutMs = 1000, bool *pExitFlag = NULL);
+	int					GetCmdResponse(unsigned char cmd, void *pRespBuf, int *pnRespBytes, int nTimeoutMs, bool *pExitFlag, bool *pbTimeout);
+	void				FinishCmd(unsigned char cmd, void *pParams, int nParamBytes, int nResult, bool bTimeout);
+	virtual void		OnCmdSucceeded(unsigned char cmd, void *pParams, int nParamBytes);
+	void				TrackMeasurementSequence(const unsigned char *pSequenceNumbers, const unsigned long long *pTimestampsNs,
+							int nNumMeasurements, int nNumMeasurementsPerPacket, unsigned long long *pEstimatedTimesNs);
+	void				ResetTimeline();
 
 	static real			kVoltsPerBit_ProbeTypeAnalog5V;
 	static real			kVoltsOffset_ProbeTypeAnalog5V;
@@ -141,6 +281,21 @@ protected:
 	static real			kVoltsOffset_ProbeTypeAnalog10V;
 
 	int					m_nLatestRawMeasurement;
+	unsigned int		m_nVoltageConversionVersion;
+	std::vector<GSkipPacket> m_measurementPacketRetrievalBuffer;
+	std::vector<unsigned char> m_sequenceNumberRetrievalBuffer;
+	std::vector<unsigned long long> m_timestampRetrievalBuffer;
+
+	bool				m_bExpectedSequenceNumberValid;	// false until the first measurement after measurements start or ClearIO().
+	unsigned char		m_nExpectedSequenceNumber;
+	unsigned long long	m_nNumMeasurementsRead;
+	unsigned long long	m_nNumLostPackets;
+	unsigned long long	m_nNumLostMeasurements;
+	unsigned int		m_nNumStreamGaps;
+	GSkipStreamGap		m_streamGaps[SKIP_MAX_STREAM_GAPS_RECORDED];	// circular, m_nNumStreamGaps % SKIP_MAX_STREAM_GAPS_RECORDED is next.
+
+	unsigned long long	m_nStreamIndex;		// index of the next measurement since measurements started, counting lost ones.
+	GSkipTimelineEstimator m_timeline;
     bool                m_bIsMeasuring;
 	unsigned int		m_hostIOStatus;
 	unsigned char		m_lastCmd;
@@ -151,6 +306,23 @@ protected:
 	GCircularBuffer		*m_diagnosticInputBufferPtr;
 	GCircularBuffer		*m_diagnosticOutputBufferPtr;
 	GPriorityMutex		*m_pTraceQueueAccessMutex;
+
+	bool				m_bAsyncCmdPending;
+	unsigned char		m_asyncCmd;
+	unsigned char		m_asyncCmdParams[sizeof(GSkipOutputPacket) - 1];
+	int					m_nAsyncCmdParamBytes;
+	unsigned int		m_nAsyncCmdStartTime;
+	int					m_nAsyncCmdTimeoutMs;
+	bool				m_bAsyncCmdDone;	// response collected by CompleteAsyncCmd(), not yet reported by CheckAsyncCmdResponse().
+	int					m_nAsyncCmdResult;
+	unsigned char		m_asyncCmdResp[SKIP_MAX_ASYNC_CMD_RESPONSE_BYTES];
+	int					m_nAsyncCmdRespBytes;
+	unsigned char		m_asyncCmdRespStatus;
+	unsigned char		m_asyncErrorSentOvertheWire;
+
+	// A response that arrives while an async command is pending belongs to that command, so SendCmd() and
+	// GetNextResponse() call this to collect it for CheckAsyncCmdResponse() before anything else goes over the wire.
+	void				CompleteAsyncCmd(void);
 		
 private:
 	typedef GDeviceIO TBaseClass;
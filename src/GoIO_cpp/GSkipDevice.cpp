@@ -219,6 +219,40 @@ real GSkipDevice::ConvertToVoltage(int raw, EProbeType eProbeType, bool bCalibra
 		return (GSkipBaseDevice::kVoltsPerBit_ProbeTypeAnalog5V*raw + GSkipBaseDevice::kVoltsOffset_ProbeTypeAnalog5V);
 }
 
+void GSkipDevice::ConvertToVoltages(const int *pRaw, real *pVolts, int nCount, EProbeType eProbeType)
+{
+	//Same math as ConvertToVoltage(), with the flash record and probe type choices made once for the whole block.
+	real fVoltsPerBit, fVoltsOffset;
+	if (kProbeTypeAnalog10V == eProbeType)
+	{
+		fVoltsPerBit = GSkipBaseDevice::kVoltsPerBit_ProbeTypeAnalog10V;
+		fVoltsOffset = GSkipBaseDevice::kVoltsOffset_ProbeTypeAnalog10V;
+	}
+	else
+	{
+		fVoltsPerBit = GSkipBaseDevice::kVoltsPerBit_ProbeTypeAnalog5V;
+		fVoltsOffset = GSkipBaseDevice::kVoltsOffset_ProbeTypeAnalog5V;
+	}
+
+	int i;
+	if (SKIP_VALID_FLASH_SIGNATURE == m_flashRec.signature)
+	{
+		//Keep the flash record types so the products round exactly as they do in ConvertToVoltage().
+		int nADCOffset = (kProbeTypeAnalog10V == eProbeType) ? m_flashRec.vinOffset : m_flashRec.vinLowOffset;
+		float fADCSlope = (kProbeTypeAnalog10V == eProbeType) ? m_flashRec.vinSlope : m_flashRec.vinLowSlope;
+		for (i = 0; i < nCount; i++)
+		{
+			int raw = (int) floor((pRaw[i] + nADCOffset)*fADCSlope + 0.5);
+			pVolts[i] = fVoltsPerBit*raw + fVoltsOffset;
+		}
+	}
+	else
+	{
+		for (i = 0; i < nCount; i++)
+			pVolts[i] = fVoltsPerBit*pRaw[i] + fVoltsOffset;
+	}
+}
+
 int GSkipDevice::ConvertVoltageToRaw(real fVoltage, EProbeType eProbeType)
 {// this routine will convert a voltage to the raw value
  // TODO jspam, probably need to add a reverse calibrate method as well to be consistent. but for now I don't
@@ -243,36 +277,90 @@ int GSkipDevice::ReadSkipFlashRecord(
 		pFlashRec->signature = 0;//flash rec is ignored until this = VALID_FLASH_SIGNATURE
 	else
 	if (SKIP_VALID_FLASH_SIGNATURE == pFlashRec->signature)
+		ConvertSkipFlashRecordToNative(pFlashRec);
+
+	return nResult;
+}
+
+int GSkipDevice::ReadSkipFlashRecordAndSensorId(
+	GSkipFlashMemoryRecord *pFlashRec, //[o] ptr to loc to store flash record, converted to native endian format.
+	GSkipGetSensorIdCmdResponsePayload *pSensorIdPayload, //[o] response to SKIP_CMD_ID_GET_SENSOR_ID.
+	int nTimeoutMs,
+	GSkipGetSerialNumberCmdResponsePayload *pSerialNumberPayload /* = NULL */) //[o] response to SKIP_CMD_ID_GET_SERIAL_NUMBER, may be NULL.
+{
+	GSkipReadI2CMemParams readFlashParams;
+	readFlashParams.addr = 0;
+	readFlashParams.count = static_cast<unsigned char>(sizeof(GSkipFlashMemoryRecord));
+
+	GSkipPipelinedCmd cmds[3];
+	int nNumCmds = 2;
+	cmds[0].cmd = SKIP_CMD_ID_READ_LOCAL_NV_MEM;
+	cmds[0].pParams = &readFlashParams;
+	cmds[0].nParamBytes = sizeof(readFlashParams);
+	cmds[0].pRespBuf = pFlashRec;
+	cmds[0].nRespBytes = sizeof(GSkipFlashMemoryRecord);
+	cmds[1].cmd = SKIP_CMD_ID_GET_SENSOR_ID;
+	cmds[1].pParams = NULL;
+	cmds[1].nParamBytes = 0;
+	cmds[1].pRespBuf = pSensorIdPayload;
+	cmds[1].nRespBytes = sizeof(GSkipGetSensorIdCmdResponsePayload);
+	if (pSerialNumberPayload)
+	{
+		cmds[2].cmd = SKIP_CMD_ID_GET_SERIAL_NUMBER;
+		cmds[2].pParams = NULL;
+		cmds[2].nParamBytes = 0;
+		cmds[2].pRespBuf = pSerialNumberPayload;
+		cmds[2].nRespBytes = sizeof(GSkipGetSerialNumberCmdResponsePayload);
+		nNumCmds++;
+	}
+
+	SendCmdsAndGetResponses(cmds, nNumCmds, nTimeoutMs);
+	int nResult = ((kResponse_OK == cmds[0].nResult) && (kResponse_OK == cmds[1].nResult)) ? kResponse_OK : kResponse_Error;
+
+	if (pSerialNumberPayload && ((kResponse_OK != cmds[2].nResult) || (cmds[2].nRespBytes != (int) sizeof(GSkipGetSerialNumberCmdResponsePayload))))
+		memset(pSerialNumberPayload, 0, sizeof(GSkipGetSerialNumberCmdResponsePayload));
+
+	if ((kResponse_OK != cmds[0].nResult) || (cmds[0].nRespBytes != (int) sizeof(GSkipFlashMemoryRecord)))
 	{
-		//Handle endian issues.
-		unsigned char * pLSB;
-		unsigned char * pLMidB;
-		unsigned char * pMMidB;
-		unsigned char * pMSB;
-		pMSB = (unsigned char *) &(pFlashRec->vinOffset);
-		pLSB = pMSB + 1;
-		GUtils::OSConvertBytesToShort(*pLSB, *pMSB, &(pFlashRec->vinOffset));
-		
-		pMSB = (unsigned char *) &(pFlashRec->vinLowOffset);
-		pLSB = pMSB + 1;
-		GUtils::OSConvertBytesToShort(*pLSB, *pMSB, &(pFlashRec->vinLowOffset));
-
-		pMSB = (unsigned char *) &(pFlashRec->vinSlope);
-		pMMidB = pMSB + 1;
-		pLMidB = pMMidB + 1;
-		pLSB = pLMidB + 1;
-		GUtils::OSConvertBytesToFloat(*pLSB, *pLMidB, *pMMidB, *pMSB, &(pFlashRec->vinSlope));
-
-		pMSB = (unsigned char *) &(pFlashRec->vinLowSlope);
-		pMMidB = pMSB + 1;
-		pLMidB = pMMidB + 1;
-		pLSB = pLMidB + 1;
-		GUtils::OSConvertBytesToFloat(*pLSB, *pLMidB, *pMMidB, *pMSB, &(pFlashRec->vinLowSlope));
+		pFlashRec->signature = 0;//flash rec is ignored until this = VALID_FLASH_SIGNATURE
+		nResult = kResponse_Error;
 	}
+	else
+	if (SKIP_VALID_FLASH_SIGNATURE == pFlashRec->signature)
+		ConvertSkipFlashRecordToNative(pFlashRec);
 
 	return nResult;
 }
 
+void GSkipDevice::ConvertSkipFlashRecordToNative(
+	GSkipFlashMemoryRecord *pRec)	//[in, out] The numeric fields in this record came from Skip in big endian format.
+{
+	//Handle endian issues.
+	unsigned char * pLSB;
+	unsigned char * pLMidB;
+	unsigned char * pMMidB;
+	unsigned char * pMSB;
+	pMSB = (unsigned char *) &(pRec->vinOffset);
+	pLSB = pMSB + 1;
+	GUtils::OSConvertBytesToShort(*pLSB, *pMSB, &(pRec->vinOffset));
+	
+	pMSB = (unsigned char *) &(pRec->vinLowOffset);
+	pLSB = pMSB + 1;
+	GUtils::OSConvertBytesToShort(*pLSB, *pMSB, &(pRec->vinLowOffset));
+
+	pMSB = (unsigned char *) &(pRec->vinSlope);
+	pMMidB = pMSB + 1;
+	pLMidB = pMMidB + 1;
+	pLSB = pLMidB + 1;
+	GUtils::OSConvertBytesToFloat(*pLSB, *pLMidB, *pMMidB, *pMSB, &(pRec->vinSlope));
+
+	pMSB = (unsigned char *) &(pRec->vinLowSlope);
+	pMMidB = pMSB + 1;
+	pLMidB = pMMidB + 1;
+	pLSB = pLMidB + 1;
+	GUtils::OSConvertBytesToFloat(*pLSB, *pLMidB, *pMMidB, *pMSB, &(pRec->vinLowSlope));
+}
+
 int GSkipDevice::WriteSkipFlashRecord(
 	const GSkipFlashMemoryRecord &flashRec, //[i] The numeric fields in this record are stored on Skip
 										//in big endian format. This routine converts the numbers from the
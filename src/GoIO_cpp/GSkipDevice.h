@@ -69,13 +69,19 @@ public:
 	real				GetMaximumMeasurementPeriodInSeconds(void) { return k_fSkipMaxDeltaT; } 
 
 	virtual real		ConvertToVoltage(int raw, EProbeType eProbeType, bool bCalibrateADCReading = true);
+	virtual void		ConvertToVoltages(const int *pRaw, real *pVolts, int nCount, EProbeType eProbeType);
 	int					ConvertVoltageToRaw(real fVoltage, EProbeType eProbeType);
 
-	void				SetSkipFlashRecord(const GSkipFlashMemoryRecord &rec) { m_flashRec = rec; }
+	void				SetSkipFlashRecord(const GSkipFlashMemoryRecord &rec) { m_flashRec = rec; m_nVoltageConversionVersion++; }
 	void				GetSkipFlashRecord(GSkipFlashMemoryRecord *pRec) { *pRec = m_flashRec; }
 
 	int					WriteSkipFlashRecord(const GSkipFlashMemoryRecord &rec, int nTimeoutMs);
 	int					ReadSkipFlashRecord(GSkipFlashMemoryRecord *pRec, int nTimeoutMs);
+	// Read the flash record and the sensor id with one pipelined exchange, see SendCmdsAndGetResponses().
+	// If pSerialNumberPayload is not NULL, then SKIP_CMD_ID_GET_SERIAL_NUMBER is added to the exchange. Failure to get the
+	// serial number is not treated as an error, (*pSerialNumberPayload) is just zeroed.
+	int					ReadSkipFlashRecordAndSensorId(GSkipFlashMemoryRecord *pRec, GSkipGetSensorIdCmdResponsePayload *pSensorIdPayload,
+							int nTimeoutMs, GSkipGetSerialNumberCmdResponsePayload *pSerialNumberPayload = NULL);
 
 private:
 	typedef GSkipBaseDevice TBaseClass;
@@ -83,6 +89,8 @@ private:
 	int					SendInitCmdAndGetResponse(void *pParams, int nParamBytes, void *pRespBuf, int *pnRespBytes, 
 							int nTimeoutMs, bool *pExitFlag = NULL);
 
+	static void			ConvertSkipFlashRecordToNative(GSkipFlashMemoryRecord *pRec);
+
 	static StringVector	m_snapshotOfAvailableDevices;
 	GSkipFlashMemoryRecord m_flashRec;
 };
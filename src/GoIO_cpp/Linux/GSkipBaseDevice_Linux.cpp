@@ -33,127 +33,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #import "GSkipBaseDevice.h"
 #import "GTextUtils.h"
 #import "GUtils.h"
+#include "LSkipRing.h"
 #include <dirent.h>
 #include <poll.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <errno.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <vector>
 
 #ifdef LIB_NAMESPACE
 namespace LIB_NAMESPACE {
 #endif
 
-struct LSkipPacketCircularBuffer
-{
-	LSkipPacketCircularBuffer(int numRecs);
-	~LSkipPacketCircularBuffer();
-
-	void SetQueueAccessMutex(OSMutex pQueueAccessMutex) {m_pQueueAccessMutex = pQueueAccessMutex;}
-	void AddRec(GSkipPacket *pRec);
-	bool RetrieveRec(GSkipPacket *pRec);
-	int NumRecsAvailable();
-	void Clear();
-
-	OSMutex m_pQueueAccessMutex; //Not responsible for creation/destruction of this object.
-	GSkipPacket *m_pRecs;
-	int	m_nFirstRec;
-	int m_nNextRec;
-	int m_nRecsAllocated;
-};
-
-LSkipPacketCircularBuffer::LSkipPacketCircularBuffer(int numRecs)
-{
-	m_pRecs = new GSkipPacket[numRecs];
-	m_pQueueAccessMutex = NULL;
-	m_nRecsAllocated = numRecs;
-	m_nFirstRec = 0;
-	m_nNextRec = 0;
-
-}
-
-LSkipPacketCircularBuffer::~LSkipPacketCircularBuffer()
-{
-	delete [] m_pRecs;
-}
-
-void LSkipPacketCircularBuffer::AddRec(GSkipPacket *pRec)
-{
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			if (NumRecsAvailable() == (m_nRecsAllocated - 1))
-			{
-				//Buffer is full, so advance first record index.
-				//Note that even though space for m_nRecsAllocated recs exists, we only report available counts from 0 to (m_nRecsAllocated-1).
-				m_nFirstRec++;
-				if (m_nFirstRec == m_nRecsAllocated)
-					m_nFirstRec = 0;
-				if (1 == m_nFirstRec)
-					GSTD_TRACE("LSkipPacketCircularBuffer measurement buffer overflowed.");
-			}
-
-			m_pRecs[m_nNextRec] = (*pRec);
-			m_nNextRec++;
-			if (m_nNextRec == m_nRecsAllocated)
-				m_nNextRec = 0;
-
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-}
-
-bool LSkipPacketCircularBuffer::RetrieveRec(GSkipPacket *pRec)
-{
-	bool bRecRetrieved = false;
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			if (NumRecsAvailable() > 0)
-			{
-				(*pRec) = m_pRecs[m_nFirstRec];
-				m_nFirstRec++;
-				if (m_nFirstRec == m_nRecsAllocated)
-					m_nFirstRec = 0;
-				bRecRetrieved = true;
-			}
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-	return bRecRetrieved;
-}
-
-int LSkipPacketCircularBuffer::NumRecsAvailable()
-{
-	int numRecs = 0;
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			numRecs = m_nNextRec - m_nFirstRec;
-			if (numRecs < 0)
-				numRecs += m_nRecsAllocated;
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-	return numRecs;
-}
-
-void LSkipPacketCircularBuffer::Clear()
-{
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			m_nFirstRec = 0;
-			m_nNextRec = 0;
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-}
-
+//Size of the read() buffer, in 8 byte reports.
+#define LSKIP_MAX_REPORTS_PER_READ 64
 
 struct LSkipMgr
 {
@@ -161,32 +59,62 @@ struct LSkipMgr
 	~LSkipMgr();
 	int Open(const cppstring &filename);
 	int Close();
-/*
-	void AddMeasurementPacket(GSkipPacket *pRec);
-	void AddCmdRespPacket(GSkipPacket *pRec);
-	void WritePacket(GSkipPacket *pRec);
-	*/
+
+	void AddPackets(GSkipPacket *pPackets, int nNumPackets);
+	void ReadPackets();
+
+	//kPacketQueueOverflow_BlockProducer back-pressure. While m_backPressure is paused the reactor stops watching this
+	//device's fd, so the reports wait in the driver without holding up the other devices.
+	void ReleaseBackPressure();
+	void WatchFd(bool bWatch);
+	int GetBackPressureHeadroom() { return LSKIP_MAX_REPORTS_PER_READ*SKIP_MAX_MEASUREMENTS_IN_PACKET; }
+
+	//One epoll reactor thread watches the fds of every open device. It is started by the first Open() and
+	//stopped by the last Close().
+	static bool	gAddToReactor(LSkipMgr *pMgr);
+	static void	gRemoveFromReactor(LSkipMgr *pMgr);
 	static int	gListenForResponse(void *pParam);
-	static int	gExitThread(void *pParam);
-	static int	gStartThread(void *pParam);
 
-	OSMutex 			m_pQueueAccessMutex;
 	int 				m_hDeviceID;
-	GThread 			*m_pListeningThread;
-	LSkipPacketCircularBuffer 	*m_pMesBuf;
-	LSkipPacketCircularBuffer	*m_pCmdBuf;
-	unsigned char m_lastNumMeasurementsInPacket;
+	bool				m_bInReactor;	// guarded by m_backPressure
+	LSkipBackPressure	m_backPressure;
+	LSkipSampleRing		*m_pMesBuf;	//Measurements decoded by m_pDecodeMeasurementPackets, tagged with sequence numbers and arrival times.
+	int					m_nNumMeasurementsInLastPacket;	//Written by the listener with __atomic builtins.
+	LSkipLatestMeasurement m_latestMeasurement;
+	LSkipPacketRing		*m_pCmdBuf;
+	GSkipBaseDevice::MeasurementPacketBatchDecoderPtr m_pDecodeMeasurementPackets;
+
+	//Signalled whenever a cmd response packet is queued, see WaitForCmdRespPackets().
+	void SignalCmdRespPackets();
+	int WaitForCmdRespPackets(int nTimeoutMs);
+	pthread_mutex_t		m_cmdRespMutex;
+	pthread_cond_t		m_cmdRespCond;
+
+	//read() statistics, reported when the device is closed.
+	unsigned int		m_nNumReadCalls;
+	unsigned int		m_nNumReportsRead;
+	unsigned int		m_nMaxReportsPerRead;
 };
 
 LSkipMgr::LSkipMgr()
 {
-	m_pQueueAccessMutex = NULL;
-	m_pListeningThread = NULL;
+	m_bInReactor = false;
 	m_hDeviceID = -1;
-	m_lastNumMeasurementsInPacket = 0;
-
-	m_pMesBuf = new LSkipPacketCircularBuffer(2000);
-	m_pCmdBuf = new LSkipPacketCircularBuffer(2000);
+	m_pDecodeMeasurementPackets = GSkipBaseDevice::DecodeSkipMeasurementPackets;
+	m_nNumMeasurementsInLastPacket = 1;
+	m_nNumReadCalls = 0;
+	m_nNumReportsRead = 0;
+	m_nMaxReportsPerRead = 0;
+
+	m_pMesBuf = new LSkipSampleRing(LSKIP_DEFAULT_NUM_QUEUED_MEASUREMENTS, true, true);
+	m_pCmdBuf = new LSkipPacketRing(LSKIP_DEFAULT_NUM_QUEUED_PACKETS);
+
+	pthread_mutex_init(&m_cmdRespMutex, NULL);
+	pthread_condattr_t condAttr;
+	pthread_condattr_init(&condAttr);
+	pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+	pthread_cond_init(&m_cmdRespCond, &condAttr);
+	pthread_condattr_destroy(&condAttr);
 }
 
 LSkipMgr::~LSkipMgr()
@@ -204,15 +132,49 @@ LSkipMgr::~LSkipMgr()
 		delete m_pCmdBuf;
 		m_pCmdBuf = NULL;
 	}
+
+	pthread_cond_destroy(&m_cmdRespCond);
+	pthread_mutex_destroy(&m_cmdRespMutex);
+}
+
+void LSkipMgr::SignalCmdRespPackets()
+{
+	pthread_mutex_lock(&m_cmdRespMutex);
+	pthread_cond_broadcast(&m_cmdRespCond);
+	pthread_mutex_unlock(&m_cmdRespMutex);
+}
+
+int LSkipMgr::WaitForCmdRespPackets(int nTimeoutMs)
+{
+	int nPackets = 0;
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += nTimeoutMs/1000;
+	deadline.tv_nsec += (nTimeoutMs % 1000)*1000000L;
+	if (deadline.tv_nsec >= 1000000000L)
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	//The listener queues the packet before signalling under m_cmdRespMutex, so a packet that arrives between
+	//the NumRecsAvailable() check and pthread_cond_timedwait() cannot be missed.
+	pthread_mutex_lock(&m_cmdRespMutex);
+	while (m_pCmdBuf && (0 == (nPackets = m_pCmdBuf->NumRecsAvailable())))
+	{
+		if (0 != pthread_cond_timedwait(&m_cmdRespCond, &m_cmdRespMutex, &deadline))
+			break;
+	}
+	pthread_mutex_unlock(&m_cmdRespMutex);
+
+	return nPackets;
 }
 
 int LSkipMgr::Open(const cppstring &filename)
 {
 	int nResult = kResponse_OK;
 
-	m_pQueueAccessMutex = GThread::OSCreateMutex(GSTD_S(""));  
-
-	if (m_pMesBuf && m_pCmdBuf && m_pQueueAccessMutex)
+	if (m_pMesBuf && m_pCmdBuf)
 	{
 
 		m_hDeviceID = open(filename.c_str(), O_RDWR|O_EXCL);
@@ -235,22 +197,21 @@ int LSkipMgr::Open(const cppstring &filename)
 				numBytesRead += numNewBytesRead;
 			}
 			printf("Go input queue contained %d bytes when device opened.\n:", numBytesRead);
+
+			//The reactor drains the fd until read() reports EAGAIN, so it must not block.
+			fcntl(m_hDeviceID, F_SETFL, fcntl(m_hDeviceID, F_GETFL) | O_NONBLOCK);
 		}
 		else
 			nResult = kResponse_Error;
 
 		if (kResponse_OK == nResult)
 		{	
-			/*jentodo is it because the main thread loop is processing the reads and sleeping for 30ms that everything is so slow.*/
-			m_pMesBuf->SetQueueAccessMutex(m_pQueueAccessMutex);
-			m_pCmdBuf->SetQueueAccessMutex(m_pQueueAccessMutex);
-			m_pListeningThread = new GThread(((StdThreadFunctionPtr)LSkipMgr::gListenForResponse),
-						NULL, NULL, NULL, NULL, (void *) this, NULL, false);
-			if (!m_pListeningThread)
+			bool bInReactor = gAddToReactor(this);
+			m_backPressure.Lock();
+			m_bInReactor = bInReactor;
+			m_backPressure.Unlock();
+			if (!bInReactor)
 				nResult = kResponse_Error;
-			else
-				if (!m_pListeningThread->OSStartThread())
-					nResult = kResponse_Error;
 		}
 	}
 	else
@@ -264,22 +225,19 @@ int LSkipMgr::Close()
 {
 	int nResult = kResponse_Error;
 
-    if (m_pListeningThread)
-    {
-        delete m_pListeningThread;
-        m_pListeningThread = NULL;
-    }
-
-	if (m_pMesBuf)
-		m_pMesBuf->SetQueueAccessMutex(NULL);
-
-	if (m_pCmdBuf)
-		m_pCmdBuf->SetQueueAccessMutex(NULL);
+	m_backPressure.Lock();
+	bool bInReactor = m_bInReactor;
+	m_bInReactor = false;
+	m_backPressure.Unlock();
+	if (bInReactor)
+		gRemoveFromReactor(this);//Once this returns, the reactor thread no longer touches this object.
 
-	if (m_pQueueAccessMutex)
+	if (m_nNumReadCalls > 0)
 	{
-		GThread::OSDestroyMutex(m_pQueueAccessMutex);
-		m_pQueueAccessMutex = NULL;
+		char tmpstring[150];
+		sprintf(tmpstring, "ldusb fd %d: %u reports in %u read() calls, max %u reports per call.", 
+			m_hDeviceID, m_nNumReportsRead, m_nNumReadCalls, m_nMaxReportsPerRead);
+		GSTD_TRACE(tmpstring);
 	}
 
 	close(m_hDeviceID);
@@ -289,80 +247,295 @@ int LSkipMgr::Close()
 	return nResult;
 }
 
-int LSkipMgr::gListenForResponse(void *pParam)
+void LSkipMgr::AddPackets(GSkipPacket *pPackets, int nNumPackets)
 {
-	int nResult = kResponse_OK;
-	LSkipMgr *pMgr = (LSkipMgr *)pParam;
-  
-	if (pMgr)
-    {
-      unsigned char buf[8];  //jenhack
-      struct pollfd fds[1];
-      int timeout_msecs = 5;
-      int count = 0;
-      static int err_count = 0;
-      
-      /* Open STREAMS device. */
-      fds[0].fd = pMgr->m_hDeviceID;
-      fds[0].events = POLLIN | POLLPRI;
-      
-      while ((poll(fds, 1, timeout_msecs)>0) && (count < 20))
-        {
-          /*Jentodo - do we need to sync with the writes before doing this.  I don't think so but I want to check*/
-          int nNumberOfBytesRead = read (fds[0].fd,&buf,sizeof(buf));
-          
-          if(nNumberOfBytesRead==sizeof(buf))
-            {
-              //Add packet to appropriate queue.
-              if ((buf[0] & SKIP_MASK_INPUT_PACKET_TYPE))
-                {
-                  if (pMgr->m_pCmdBuf)
-                    pMgr->m_pCmdBuf->AddRec((GSkipPacket *) (&buf[0]));
-                }
-              else
-                {
-                  if (pMgr->m_pMesBuf)
-                    {
-                      pMgr->m_pMesBuf->AddRec((GSkipPacket *) (&buf[0]));
-                      GSkipMeasurementPacket *pMeasRec = (GSkipMeasurementPacket *) (&buf[0]);
-                      pMgr->m_lastNumMeasurementsInPacket = pMeasRec->nMeasurementsInPacket;
-                    }
-                }
-              
-              /* Reset error on succesful read. */
-              err_count = 0;
-            }
-          else
-            {
-              if (5 > ++err_count)
-                {
-                  printf("Bad we did not get all the bytes. Dropped %d bytes. Error: %s\n", nNumberOfBytesRead, strerror(errno));                  
-                }
-              GUtils::OSSleep (1);
-            }
-          
-          count++;
-        }
-    }
-  
-  return nResult;
-}
-
-/*
-
-int LSkipMgr::gExitThread(void *pParam)
+	GSkipPacket cmdPackets[LSKIP_MAX_REPORTS_PER_READ];
+	int measurements[LSKIP_MAX_REPORTS_PER_READ*SKIP_MAX_MEASUREMENTS_IN_PACKET];
+	unsigned char sequenceNumbers[LSKIP_MAX_REPORTS_PER_READ*SKIP_MAX_MEASUREMENTS_IN_PACKET];
+	unsigned long long timestamps[LSKIP_MAX_REPORTS_PER_READ*SKIP_MAX_MEASUREMENTS_IN_PACKET];
+	//Every report in the batch came back from the same read(), so they share one arrival time.
+	unsigned long long nArrivalTimeNs = LSkipGetMonotonicTimeNs();
+	int nNumCmdPackets = 0;
+	int nNumMeasurements = 0;
+	int nNumInPacket = 0;
+
+	//Classify every report in one pass. Command responses are copied aside and each run of measurement packets is
+	//decoded right here with one batch decoder call, so each queue is then updated with a single AddRecs() call.
+	int i = 0;
+	while (i < nNumPackets)
+	{
+		if (pPackets[i].data[0] & SKIP_MASK_INPUT_PACKET_TYPE)
+			cmdPackets[nNumCmdPackets++] = pPackets[i++];
+		else
+		{
+			int nFirstPacket = i;
+			while ((i < nNumPackets) && !(pPackets[i].data[0] & SKIP_MASK_INPUT_PACKET_TYPE))
+				i++;
+			nNumMeasurements += m_pDecodeMeasurementPackets(&pPackets[nFirstPacket], i - nFirstPacket,
+				&measurements[nNumMeasurements], &sequenceNumbers[nNumMeasurements], &nNumInPacket);
+		}
+	}
+	for (int j = 0; j < nNumMeasurements; j++)
+		timestamps[j] = nArrivalTimeNs;
+
+	if (nNumInPacket > 0)
+		__atomic_store_n(&m_nNumMeasurementsInLastPacket, nNumInPacket, __ATOMIC_RELAXED);
+	if (nNumMeasurements > 0)
+		m_latestMeasurement.Publish(measurements[nNumMeasurements - 1], nArrivalTimeNs);
+
+	if ((nNumCmdPackets > 0) && m_pCmdBuf)
+	{
+		m_pCmdBuf->AddRecs(cmdPackets, nNumCmdPackets);
+		SignalCmdRespPackets();
+	}
+
+	if ((nNumMeasurements > 0) && m_pMesBuf)
+		m_pMesBuf->AddRecs(measurements, nNumMeasurements, sequenceNumbers, timestamps);
+}
+
+void LSkipMgr::ReadPackets()
 {
-	int nResult = kResponse_OK;
-	pthread_exit(NULL);
-	return nResult;
+	static int err_count = 0;
+	GSkipPacket packets[LSKIP_MAX_REPORTS_PER_READ];
+
+	//Drain everything the driver has buffered, the fd is non blocking.
+	//Ask for as many reports as fit in the buffer. Drivers that hand back only one report per call still work,
+	//we just loop more.
+	while (true)
+	{
+		int nNumberOfBytesRead = read(m_hDeviceID, packets, sizeof(packets));
+		if (nNumberOfBytesRead <= 0)
+		{
+			if ((nNumberOfBytesRead < 0) && (EAGAIN != errno) && (EINTR != errno) && (5 > ++err_count))
+				printf("Error reading from ldusb fd %d. Error: %s\n", m_hDeviceID, strerror(errno));
+			break;
+		}
+
+		int nNumReports = nNumberOfBytesRead/sizeof(GSkipPacket);
+		m_nNumReadCalls++;
+		m_nNumReportsRead += nNumReports;
+		if ((unsigned int) nNumReports > m_nMaxReportsPerRead)
+			m_nMaxReportsPerRead = nNumReports;
+
+		if ((nNumberOfBytesRead % sizeof(GSkipPacket)) != 0)
+		{
+			if (5 > ++err_count)
+			{
+				printf("Bad we did not get all the bytes. Dropped %d bytes.\n", (int) (nNumberOfBytesRead % sizeof(GSkipPacket)));
+			}
+		}
+		else
+		{
+			/* Reset error on succesful read. */
+			err_count = 0;
+		}
+
+		AddPackets(packets, nNumReports);
+
+		//Leave the rest in the driver if the measurement queue can not take another read under kPacketQueueOverflow_BlockProducer.
+		m_backPressure.Lock();
+		bool bPaused = m_backPressure.ShouldPause(m_pMesBuf, GetBackPressureHeadroom());
+		if (bPaused)
+			WatchFd(false);
+		m_backPressure.Unlock();
+		if (bPaused)
+			break;
+	}
 }
 
-int LSkipMgr::gStartThread(void *pParam)
+static pthread_mutex_t g_reactorLifeMutex = PTHREAD_MUTEX_INITIALIZER;//Serializes gAddToReactor() and gRemoveFromReactor().
+static pthread_mutex_t g_reactorMutex = PTHREAD_MUTEX_INITIALIZER;//Held by the reactor thread while it dispatches events.
+static std::vector<LSkipMgr *> g_reactorMgrs;
+static int g_reactorEpollFd = -1;
+static int g_reactorWakeFd = -1;
+static GThread *g_pReactorThread = NULL;
+static volatile bool g_bReactorStop = false;
+
+bool LSkipMgr::gAddToReactor(LSkipMgr *pMgr)
 {
-	return kResponse_OK;
+	bool bResult = false;
+
+	pthread_mutex_lock(&g_reactorLifeMutex);
+	if (NULL == g_pReactorThread)
+	{
+		g_reactorEpollFd = epoll_create(16);
+		g_reactorWakeFd = eventfd(0, EFD_NONBLOCK);
+		if ((g_reactorEpollFd != -1) && (g_reactorWakeFd != -1))
+		{
+			struct epoll_event ev;
+			ev.events = EPOLLIN;
+			ev.data.ptr = NULL;//NULL => wake up request from gRemoveFromReactor().
+			epoll_ctl(g_reactorEpollFd, EPOLL_CTL_ADD, g_reactorWakeFd, &ev);
+
+			g_bReactorStop = false;
+			g_pReactorThread = new GThread(((StdThreadFunctionPtr)LSkipMgr::gListenForResponse),
+						NULL, NULL, NULL, NULL, NULL, NULL, false);
+			if (g_pReactorThread && !g_pReactorThread->OSStartThread())
+			{
+				delete g_pReactorThread;
+				g_pReactorThread = NULL;
+			}
+		}
+
+		if (NULL == g_pReactorThread)
+		{
+			if (g_reactorEpollFd != -1)
+				close(g_reactorEpollFd);
+			if (g_reactorWakeFd != -1)
+				close(g_reactorWakeFd);
+			g_reactorEpollFd = g_reactorWakeFd = -1;
+		}
+	}
+
+	if (NULL != g_pReactorThread)
+	{
+		struct epoll_event ev;
+		ev.events = EPOLLIN;
+		ev.data.ptr = pMgr;
+		pthread_mutex_lock(&g_reactorMutex);
+		if (0 == epoll_ctl(g_reactorEpollFd, EPOLL_CTL_ADD, pMgr->m_hDeviceID, &ev))
+		{
+			g_reactorMgrs.push_back(pMgr);
+			bResult = true;
+		}
+		else
+			printf("Unable to add fd %d to epoll reactor. Error: %s\n", pMgr->m_hDeviceID, strerror(errno));
+		pthread_mutex_unlock(&g_reactorMutex);
+	}
+	pthread_mutex_unlock(&g_reactorLifeMutex);
+
+	return bResult;
+}
+
+void LSkipMgr::gRemoveFromReactor(LSkipMgr *pMgr)
+{
+	bool bStopReactor = false;
+
+	//The reactor thread dispatches events while holding g_reactorMutex and ignores fds that are no longer in
+	//g_reactorMgrs, so after this block pMgr is never referenced again.
+	pthread_mutex_lock(&g_reactorLifeMutex);
+	pthread_mutex_lock(&g_reactorMutex);
+	epoll_ctl(g_reactorEpollFd, EPOLL_CTL_DEL, pMgr->m_hDeviceID, NULL);
+	for (size_t ix = 0; ix < g_reactorMgrs.size(); ix++)
+	{
+		if (g_reactorMgrs[ix] == pMgr)
+		{
+			g_reactorMgrs.erase(g_reactorMgrs.begin() + ix);
+			break;
+		}
+	}
+	if (g_reactorMgrs.empty() && (NULL != g_pReactorThread))
+	{
+		bStopReactor = true;
+		g_bReactorStop = true;
+		eventfd_write(g_reactorWakeFd, 1);
+	}
+	pthread_mutex_unlock(&g_reactorMutex);
+
+	if (bStopReactor)
+	{
+		delete g_pReactorThread;//Waits for gListenForResponse() to return.
+		g_pReactorThread = NULL;
+		close(g_reactorEpollFd);
+		close(g_reactorWakeFd);
+		g_reactorEpollFd = g_reactorWakeFd = -1;
+	}
+	pthread_mutex_unlock(&g_reactorLifeMutex);
+}
+
+void LSkipMgr::WatchFd(bool bWatch)
+{
+	//Caller holds m_backPressure's lock. EPOLLERR and EPOLLHUP are reported even while EPOLLIN is not watched.
+	if (m_bInReactor)
+	{
+		struct epoll_event ev;
+		ev.events = bWatch ? (uint32_t) EPOLLIN : 0u;
+		ev.data.ptr = this;
+		if (0 != epoll_ctl(g_reactorEpollFd, EPOLL_CTL_MOD, m_hDeviceID, &ev))
+			printf("Unable to %s fd %d in epoll reactor. Error: %s\n", bWatch ? "resume" : "pause", m_hDeviceID, strerror(errno));
+	}
+}
+
+void LSkipMgr::ReleaseBackPressure()
+{
+	//Called by the consumer after it has taken measurements out of the queue, or changed the queue.
+	m_backPressure.Lock();
+	if (m_backPressure.ShouldResume(m_pMesBuf, GetBackPressureHeadroom()))
+		WatchFd(true);
+	m_backPressure.Unlock();
+}
+
+int LSkipMgr::gListenForResponse(void * /*pParam*/)
+{
+	int nResult = kResponse_OK;
+	int epollFd = g_reactorEpollFd;
+	struct epoll_event events[32];
+
+	//Sleep in epoll_wait() until a device has reports buffered, so an idle reactor costs nothing. While a device is
+	//paused by back-pressure, wake up every 10 ms to check its block timeout.
+	bool bAnyPaused = false;
+	while (!g_bReactorStop)
+	{
+		int nEvents = epoll_wait(epollFd, events, 32, bAnyPaused ? 10 : -1);
+		if (nEvents < 0)
+		{
+			if (EINTR == errno)
+				continue;
+			printf("epoll_wait failed. Error: %s\n", strerror(errno));
+			break;
+		}
+
+		pthread_mutex_lock(&g_reactorMutex);
+		for (int i = 0; i < nEvents; i++)
+		{
+			LSkipMgr *pMgr = (LSkipMgr *) events[i].data.ptr;
+			if (NULL == pMgr)
+			{
+				eventfd_t value;
+				eventfd_read(g_reactorWakeFd, &value);
+				continue;
+			}
+
+			bool bRegistered = false;
+			for (size_t ix = 0; ix < g_reactorMgrs.size(); ix++)
+			{
+				if (g_reactorMgrs[ix] == pMgr)
+				{
+					bRegistered = true;
+					break;
+				}
+			}
+			if (!bRegistered)
+				continue;//Removed after epoll_wait() returned.
+
+			if (events[i].events & EPOLLIN)
+				pMgr->ReadPackets();
+			if (events[i].events & (EPOLLERR | EPOLLHUP))
+			{
+				//Device was unplugged. Stop watching it so a level triggered error does not spin the reactor.
+				printf("ldusb fd %d reported an error, no longer listening to it.\n", pMgr->m_hDeviceID);
+				epoll_ctl(epollFd, EPOLL_CTL_DEL, pMgr->m_hDeviceID, NULL);
+			}
+		}
+
+		//Pauses only start in here, so this sees all of them.
+		bAnyPaused = false;
+		for (size_t ix = 0; ix < g_reactorMgrs.size(); ix++)
+		{
+			LSkipMgr *pMgr = g_reactorMgrs[ix];
+			pMgr->m_backPressure.Lock();
+			if (pMgr->m_backPressure.ShouldResumeAfterTimeout())
+				pMgr->WatchFd(true);
+			if (pMgr->m_backPressure.IsPaused())
+				bAnyPaused = true;
+			pMgr->m_backPressure.Unlock();
+		}
+		pthread_mutex_unlock(&g_reactorMutex);
+	}
+
+	return nResult;
 }
 
-*/
 bool GSkipBaseDevice::OSInitialize(void)
 {
 	bool bResult = true;
@@ -424,6 +597,15 @@ StringVector GSkipBaseDevice::OSGetAvailableDevicesOfType(int nVendorID, int nPr
 	return vPortNames;
 }
 
+int GSkipBaseDevice::OSSetDeviceNotificationCallback(DeviceNotificationFunctionPtr /*pFunction*/, void * /*pContext*/)
+{
+	return kResponse_Error;//Hotplug notification requires the libusb backend(configure --enable-libusb).
+}
+
+void GSkipBaseDevice::OSReleaseDeviceRegistry(void)
+{
+}
+
 int GSkipBaseDevice::OSOpen(GPortRef *pPortRef)
 {
 	int nResult = kResponse_Error;
@@ -432,6 +614,7 @@ int GSkipBaseDevice::OSOpen(GPortRef *pPortRef)
 	{
 		if (LockDevice(1) && IsOKToUse())
 		{
+			((LSkipMgr*)m_pOSData)->m_pDecodeMeasurementPackets = GetMeasurementPacketBatchDecoder();
 			((LSkipMgr*)m_pOSData)->Open(pPortRef->GetLocation());
 			nResult = kResponse_OK;
 			UnlockDevice();
@@ -465,39 +648,44 @@ void GSkipBaseDevice::OSDestroy(void)
 }
 
 int GSkipBaseDevice::OSReadMeasurementPackets(
-	void * pBuffer, //[out] ptr to destination buffer
+	void * /*pBuffer*/, //[out] ptr to destination buffer
 	int * pIONumPackets, //[in, out] number of packets desired on input, number of packets read on output
-	int nBufferSizeInPackets) //[in] size of destination buffer in packets
+	int /*nBufferSizeInPackets*/) //[in] size of destination buffer in packets
+{
+	//Not used - the listener queues decoded measurements rather than packets, see OSReadMeasurements().
+	(*pIONumPackets) = 0;
+	return kResponse_Error;
+}
+
+int GSkipBaseDevice::OSReadMeasurements(
+	int * pMeasurements, //[out] ptr to destination buffer
+	unsigned char * pSequenceNumbers, //[out] ptr to destination buffer for the sequence numbers of the measurements
+	unsigned long long * pTimestampsNs, //[out] ptr to destination buffer for the arrival times of the measurements, may be NULL
+	int * pIONumMeasurements, //[in, out] number of measurements desired on input, number of measurements read on output
+	int nBufferSizeInMeasurements, //[in] size of destination buffers in measurements
+	unsigned char *pNumMeasurementsInLastPacket) //[out] number of measurements in the most recent packet
 {
 	int nResult = kResponse_Error;
-	int nPacketsRead = 0;
+	int nMeasurementsRead = 0;
 	if (NULL != m_pOSData)
 	{
 		LSkipMgr *pSkipMgr = (LSkipMgr *) m_pOSData;
-		unsigned char *pBuf = (unsigned char *) pBuffer;
-		int nPacketsDesired = (*pIONumPackets);
-		if (nPacketsDesired > nBufferSizeInPackets)
-			nPacketsDesired = nBufferSizeInPackets;
+		int nMeasurementsDesired = (*pIONumMeasurements);
+		if (nMeasurementsDesired > nBufferSizeInMeasurements)
+			nMeasurementsDesired = nBufferSizeInMeasurements;
 
 		if (LockDevice(1) && IsOKToUse())
 		{
 			nResult = kResponse_OK;
-			while (nPacketsRead < nPacketsDesired)
-			{
-				if (pSkipMgr->m_pMesBuf->RetrieveRec((GSkipPacket *) pBuf))
-				{
-					nPacketsRead++;
-					pBuf += sizeof(GSkipPacket);
-				}
-				else
-					break;
-			}
+			nMeasurementsRead = pSkipMgr->m_pMesBuf->RetrieveRecs(pMeasurements, nMeasurementsDesired, pSequenceNumbers, pTimestampsNs);
+			pSkipMgr->ReleaseBackPressure();
+			(*pNumMeasurementsInLastPacket) = (unsigned char) __atomic_load_n(&pSkipMgr->m_nNumMeasurementsInLastPacket, __ATOMIC_RELAXED);
 
 			UnlockDevice();
 		}
 	}
 
-	(*pIONumPackets) = nPacketsRead;
+	(*pIONumMeasurements) = nMeasurementsRead;
 	return nResult;
 }
 
@@ -511,7 +699,6 @@ int GSkipBaseDevice::OSReadCmdRespPackets(
 	if (NULL != m_pOSData)
 	{
 		LSkipMgr *pSkipMgr = (LSkipMgr *) m_pOSData;
-		unsigned char *pBuf = (unsigned char *) pBuffer;
 		int nPacketsDesired = (*pIONumPackets);
 		if (nPacketsDesired > nBufferSizeInPackets)
 			nPacketsDesired = nBufferSizeInPackets;
@@ -519,16 +706,7 @@ int GSkipBaseDevice::OSReadCmdRespPackets(
 		if (LockDevice(1) && IsOKToUse())
 		{
 			nResult = kResponse_OK;
-			while (nPacketsRead < nPacketsDesired)
-			{
-				if (pSkipMgr->m_pCmdBuf->RetrieveRec((GSkipPacket *) pBuf))
-				{
-					nPacketsRead++;
-					pBuf += sizeof(GSkipPacket);
-				}
-				else
-					break;
-			}
+			nPacketsRead = pSkipMgr->m_pCmdBuf->RetrieveRecs((GSkipPacket *) pBuffer, nPacketsDesired);
 
 			UnlockDevice();
 		}
@@ -560,11 +738,11 @@ int GSkipBaseDevice::OSMeasurementPacketsAvailable(unsigned char *pNumMeasuremen
 {
 	int nReturn = 0;
 
+	//The queue holds decoded measurements, so report them as 1 measurement per packet.
 	(*pNumMeasurementsInLastPacket) = 1;
 
 	if (m_pOSData && LockDevice(1) && IsOKToUse())
 	{
-		(*pNumMeasurementsInLastPacket) = ((LSkipMgr*)m_pOSData)->m_lastNumMeasurementsInPacket;
 		if (((LSkipMgr*)m_pOSData)->m_pMesBuf)
 			nReturn = ((LSkipMgr*)m_pOSData)->m_pMesBuf->NumRecsAvailable();
 
@@ -587,6 +765,18 @@ int GSkipBaseDevice::OSCmdRespPacketsAvailable(void)
 	return nReturn;
 }
 
+int GSkipBaseDevice::OSWaitForCmdRespPackets(int nTimeoutMs)
+{
+	int nReturn = 0;
+
+	if (m_pOSData && LockDevice(1) && IsOKToUse())
+	{
+		nReturn = ((LSkipMgr*)m_pOSData)->WaitForCmdRespPackets(nTimeoutMs);
+		UnlockDevice();
+	}
+	return nReturn;
+}
+
 int GSkipBaseDevice::OSClearMeasurementPacketQueue()
 {
 	int nResult = kResponse_Error;
@@ -596,7 +786,7 @@ int GSkipBaseDevice::OSClearMeasurementPacketQueue()
 		if (LockDevice(1) && IsOKToUse())
 		{
 			((LSkipMgr*)m_pOSData)->m_pMesBuf->Clear();
-			((LSkipMgr*)m_pOSData)->m_lastNumMeasurementsInPacket = 0;
+			((LSkipMgr*)m_pOSData)->ReleaseBackPressure();
 			nResult = kResponse_OK;
 			UnlockDevice();
 		}
@@ -622,6 +812,80 @@ int GSkipBaseDevice::OSClearCmdRespPacketQueue()
 	return nResult;
 }
 
+int GSkipBaseDevice::OSSetMeasurementQueueOptions(int nCapacity, int nOverflowPolicy, int nBlockTimeoutMs)
+{
+	int nResult = kResponse_Error;
+
+	if (m_pOSData && (nCapacity > 0) && (nBlockTimeoutMs >= 0) &&
+		(nOverflowPolicy >= kPacketQueueOverflow_DropOldest) && (nOverflowPolicy <= kPacketQueueOverflow_BlockProducer))
+	{
+		if (LockDevice(1) && IsOKToUse())
+		{
+			LSkipMgr *pSkipMgr = (LSkipMgr *) m_pOSData;
+			pSkipMgr->m_pMesBuf->SetOptions(nCapacity, nOverflowPolicy, nBlockTimeoutMs);
+			pSkipMgr->m_backPressure.Lock();
+			pSkipMgr->m_backPressure.SetOptions(nOverflowPolicy, nBlockTimeoutMs);
+			pSkipMgr->m_backPressure.Unlock();
+			pSkipMgr->ReleaseBackPressure();
+			nResult = kResponse_OK;
+			UnlockDevice();
+		}
+	}
+
+	return nResult;
+}
+
+int GSkipBaseDevice::OSGetMeasurementQueueOverflowCount(unsigned int *pNumDropped)
+{
+	int nResult = kResponse_Error;
+
+	if (m_pOSData)
+	{
+		if (LockDevice(1) && IsOKToUse())
+		{
+			(*pNumDropped) = ((LSkipMgr*)m_pOSData)->m_pMesBuf->GetNumRecsDropped();
+			nResult = kResponse_OK;
+			UnlockDevice();
+		}
+	}
+
+	return nResult;
+}
+
+int GSkipBaseDevice::OSPeekLatestMeasurement(int *pMeasurement, unsigned long long *pTimestampNs)
+{
+	int nResult = kResponse_Error;
+
+	//No device lock, the register is safe to read while another thread drains the queue.
+	if (m_pOSData && ((LSkipMgr*)m_pOSData)->m_latestMeasurement.Peek(pMeasurement, pTimestampNs))
+		nResult = kResponse_OK;
+
+	return nResult;
+}
+
+int GSkipBaseDevice::OSCopyRecentMeasurements(
+	int * pMeasurements, //[out] ptr to destination buffer
+	unsigned long long * pTimestampsNs, //[out] ptr to destination buffer for the arrival times, may be NULL
+	int * pIONumMeasurements) //[in, out] size of destination buffers on input, number of measurements copied on output
+{
+	int nResult = kResponse_Error;
+	int nMeasurementsCopied = 0;
+
+	if (m_pOSData)
+	{
+		//The device lock keeps Clear() and SetOptions() out while we copy.
+		if (LockDevice(1) && IsOKToUse())
+		{
+			nMeasurementsCopied = ((LSkipMgr*)m_pOSData)->m_pMesBuf->CopyNewestRecs(pMeasurements, (*pIONumMeasurements), pTimestampsNs);
+			nResult = kResponse_OK;
+			UnlockDevice();
+		}
+	}
+
+	(*pIONumMeasurements) = nMeasurementsCopied;
+	return nResult;
+}
+
 int GSkipBaseDevice::OSClearIO(void)
 {
 	int nResult = kResponse_OK;
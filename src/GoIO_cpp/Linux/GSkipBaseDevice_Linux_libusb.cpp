@@ -33,11 +33,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #import "GSkipBaseDevice.h"
 #import "GTextUtils.h"
 #import "GUtils.h"
+#include "LSkipRing.h"
 #include <dirent.h>
 #include <poll.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
 
 #include "libusb-1.0/libusb.h"
 extern libusb_context *pGoIO_libusbContext;   
@@ -46,156 +50,105 @@ extern libusb_context *pGoIO_libusbContext;
 namespace LIB_NAMESPACE {
 #endif
 
-struct LSkipPacketCircularBuffer
-{
-	LSkipPacketCircularBuffer(int numRecs);
-	~LSkipPacketCircularBuffer();
-
-	void SetQueueAccessMutex(OSMutex pQueueAccessMutex) {m_pQueueAccessMutex = pQueueAccessMutex;}
-	void AddRec(GSkipPacket *pRec);
-	bool RetrieveRec(GSkipPacket *pRec);
-	int NumRecsAvailable();
-	void Clear();
-
-	OSMutex m_pQueueAccessMutex; //Not responsible for creation/destruction of this object.
-	GSkipPacket *m_pRecs;
-	int	m_nFirstRec;
-	int m_nNextRec;
-	int m_nRecsAllocated;
-};
-
-LSkipPacketCircularBuffer::LSkipPacketCircularBuffer(int numRecs)
-{
-	m_pRecs = new GSkipPacket[numRecs];
-	m_pQueueAccessMutex = NULL;
-	m_nRecsAllocated = numRecs;
-	m_nFirstRec = 0;
-	m_nNextRec = 0;
-}
-
-LSkipPacketCircularBuffer::~LSkipPacketCircularBuffer()
-{
-	delete [] m_pRecs;
-}
+//Number of 8 byte interrupt IN transfers kept in flight per device.
+//At the 5 ms minimum measurement period, 16 transfers cover an 80 ms host stall without dropping reports.
+#ifndef LSKIP_DEFAULT_NUM_IN_TRANSFERS
+#define LSKIP_DEFAULT_NUM_IN_TRANSFERS 16
+#endif
+#define LSKIP_MAX_NUM_IN_TRANSFERS 128
 
-void LSkipPacketCircularBuffer::AddRec(GSkipPacket *pRec)
+struct LSkipMgr
 {
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			if (NumRecsAvailable() == (m_nRecsAllocated - 1))
-			{
-				//Buffer is full, so advance first record index.
-				//Note that even though space for m_nRecsAllocated recs exists, we only report available counts from 0 to (m_nRecsAllocated-1).
-				m_nFirstRec++;
-				if (m_nFirstRec == m_nRecsAllocated)
-					m_nFirstRec = 0;
-				if (1 == m_nFirstRec)
-					GSTD_TRACE("LSkipPacketCircularBuffer measurement buffer overflowed.");
-			}
-
-			m_pRecs[m_nNextRec] = (*pRec);
-			m_nNextRec++;
-			if (m_nNextRec == m_nRecsAllocated)
-				m_nNextRec = 0;
-
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-}
+	LSkipMgr(int numInTransfers = LSKIP_DEFAULT_NUM_IN_TRANSFERS);
+	~LSkipMgr();
+	int Open(const cppstring &filename);
+	int Close();
 
-bool LSkipPacketCircularBuffer::RetrieveRec(GSkipPacket *pRec)
-{
-	bool bRecRetrieved = false;
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			if (NumRecsAvailable() > 0)
-			{
-				(*pRec) = m_pRecs[m_nFirstRec];
-				m_nFirstRec++;
-				if (m_nFirstRec == m_nRecsAllocated)
-					m_nFirstRec = 0;
-				bRecRetrieved = true;
-			}
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-	return bRecRetrieved;
-}
+	void AddPacket(unsigned char *pBuf);
+	int SubmitInTransfers();
+	void CancelInTransfers();
+	void FreeInTransfers();
 
-int LSkipPacketCircularBuffer::NumRecsAvailable()
-{
-	int numRecs = 0;
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			numRecs = m_nNextRec - m_nFirstRec;
-			if (numRecs < 0)
-				numRecs += m_nRecsAllocated;
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-	return numRecs;
-}
+	//kPacketQueueOverflow_BlockProducer back-pressure. While m_backPressure is paused, completed IN transfers are parked
+	//instead of resubmitted, so the device stops sending reports without holding up the shared event thread.
+	void ReleaseBackPressure();
+	void ResumeInTransfers();
+	int GetBackPressureHeadroom() { return m_nNumInTransfers*SKIP_MAX_MEASUREMENTS_IN_PACKET; }
+	static bool gResumeExpiredPauses();
 
-void LSkipPacketCircularBuffer::Clear()
-{
-	if (m_pQueueAccessMutex != NULL)
-	{
-		if (GThread::OSLockMutex(m_pQueueAccessMutex))
-		{
-			m_nFirstRec = 0;
-			m_nNextRec = 0;
-			GThread::OSUnlockMutex(m_pQueueAccessMutex);
-		}
-	}
-}
+	static void LIBUSB_CALL gInTransferComplete(struct libusb_transfer *pTransfer);
 
+	//One event handling thread services the IN transfers of every open device. It is started by the first
+	//Open() and stopped by the last Close(), so the thread count stays flat as devices are added.
+	static bool	gAddEventThreadRef();
+	static void	gReleaseEventThreadRef();
+	static int	gHandleEvents(void *pParam);
 
-struct LSkipMgr
-{
-	LSkipMgr();
-	~LSkipMgr();
-	int Open(const cppstring &filename);
-	int Close();
-/*
-	void AddMeasurementPacket(GSkipPacket *pRec);
-	void AddCmdRespPacket(GSkipPacket *pRec);
-	void WritePacket(GSkipPacket *pRec);
-	*/
-	static int	gListenForResponse(void *pParam);
-	static int	gExitThread(void *pParam);
-	static int	gStartThread(void *pParam);
-
-	OSMutex 			m_pQueueAccessMutex;
 	libusb_device_handle *m_hDeviceFile;
-	GThread 			*m_pListeningThread;
-	LSkipPacketCircularBuffer 	*m_pMesBuf;
-	LSkipPacketCircularBuffer	*m_pCmdBuf;
-	unsigned char m_lastNumMeasurementsInPacket;
-	bool	m_stayAlive;	// this flag is true when opened, false when caller closes (so we can tell timeout from real close)
+	bool				m_bHasEventThreadRef;
+	LSkipSampleRing		*m_pMesBuf;	//Measurements decoded by m_pDecodeMeasurementPackets, tagged with sequence numbers and arrival times.
+	int					m_nNumMeasurementsInLastPacket;	//Written by the listener with __atomic builtins.
+	LSkipLatestMeasurement m_latestMeasurement;
+	LSkipPacketRing		*m_pCmdBuf;
+	GSkipBaseDevice::MeasurementPacketBatchDecoderPtr m_pDecodeMeasurementPackets;
+
+	//Signalled whenever a cmd response packet is queued, see WaitForCmdRespPackets().
+	void SignalCmdRespPackets();
+	int WaitForCmdRespPackets(int nTimeoutMs);
+	pthread_mutex_t		m_cmdRespMutex;
+	pthread_cond_t		m_cmdRespCond;
+	bool	m_stayAlive;	// this flag is true when opened, false when caller closes (so we can tell timeout from real close), guarded by m_backPressure
+
+	struct libusb_transfer **m_pInTransfers;	// ring of interrupt IN transfers, resubmitted from gInTransferComplete()
+	unsigned char		*m_pInTransferBufs;		// m_nNumInTransfers * sizeof(GSkipPacket) bytes
+	int					m_nNumInTransfers;
+	volatile int		m_nInTransfersInFlight;	// updated with __sync builtins, callbacks may run on any event handling thread
+
+	LSkipBackPressure	m_backPressure;
+	struct libusb_transfer **m_pParkedTransfers;	// guarded by m_backPressure, parked transfers are not in flight
+	int					m_nNumParkedTransfers;
 };
 
-LSkipMgr::LSkipMgr()
+//Every open device, for the event thread's back-pressure tick. Lock g_openMgrsMutex before any device's m_backPressure.
+static pthread_mutex_t g_openMgrsMutex = PTHREAD_MUTEX_INITIALIZER;
+static std::vector<LSkipMgr *> g_openMgrs;
+
+LSkipMgr::LSkipMgr(int numInTransfers)
 {
-	m_pQueueAccessMutex = NULL;
-	m_pListeningThread = NULL;
+	m_bHasEventThreadRef = false;
 	m_hDeviceFile = NULL;
-	m_lastNumMeasurementsInPacket = 0;
-
-	m_pMesBuf = new LSkipPacketCircularBuffer(2000);
-	m_pCmdBuf = new LSkipPacketCircularBuffer(2000);
+	m_pDecodeMeasurementPackets = GSkipBaseDevice::DecodeSkipMeasurementPackets;
+	m_nNumMeasurementsInLastPacket = 1;
+
+	m_pMesBuf = new LSkipSampleRing(LSKIP_DEFAULT_NUM_QUEUED_MEASUREMENTS, true, true);
+	m_pCmdBuf = new LSkipPacketRing(LSKIP_DEFAULT_NUM_QUEUED_PACKETS);
+
+	pthread_mutex_init(&m_cmdRespMutex, NULL);
+	pthread_condattr_t condAttr;
+	pthread_condattr_init(&condAttr);
+	pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+	pthread_cond_init(&m_cmdRespCond, &condAttr);
+	pthread_condattr_destroy(&condAttr);
 	m_stayAlive = false;
+
+	if (numInTransfers < 1)
+		numInTransfers = 1;
+	else
+	if (numInTransfers > LSKIP_MAX_NUM_IN_TRANSFERS)
+		numInTransfers = LSKIP_MAX_NUM_IN_TRANSFERS;
+	m_nNumInTransfers = numInTransfers;
+	m_pInTransfers = NULL;
+	m_pInTransferBufs = NULL;
+	m_nInTransfersInFlight = 0;
+	m_pParkedTransfers = NULL;
+	m_nNumParkedTransfers = 0;
 }
 
 LSkipMgr::~LSkipMgr()
 {
 	if (NULL != m_hDeviceFile)
 		Close();
+	FreeInTransfers();
 
 	if (m_pMesBuf)
 	{
@@ -207,6 +160,42 @@ LSkipMgr::~LSkipMgr()
 		delete m_pCmdBuf;
 		m_pCmdBuf = NULL;
 	}
+
+	pthread_cond_destroy(&m_cmdRespCond);
+	pthread_mutex_destroy(&m_cmdRespMutex);
+}
+
+void LSkipMgr::SignalCmdRespPackets()
+{
+	pthread_mutex_lock(&m_cmdRespMutex);
+	pthread_cond_broadcast(&m_cmdRespCond);
+	pthread_mutex_unlock(&m_cmdRespMutex);
+}
+
+int LSkipMgr::WaitForCmdRespPackets(int nTimeoutMs)
+{
+	int nPackets = 0;
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += nTimeoutMs/1000;
+	deadline.tv_nsec += (nTimeoutMs % 1000)*1000000L;
+	if (deadline.tv_nsec >= 1000000000L)
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	//The listener queues the packet before signalling under m_cmdRespMutex, so a packet that arrives between
+	//the NumRecsAvailable() check and pthread_cond_timedwait() cannot be missed.
+	pthread_mutex_lock(&m_cmdRespMutex);
+	while (m_pCmdBuf && (0 == (nPackets = m_pCmdBuf->NumRecsAvailable())))
+	{
+		if (0 != pthread_cond_timedwait(&m_cmdRespCond, &m_cmdRespMutex, &deadline))
+			break;
+	}
+	pthread_mutex_unlock(&m_cmdRespMutex);
+
+	return nPackets;
 }
 
 cppstring local_BusAndAddressToCPPStringw(uint8_t bus, 
@@ -227,9 +216,7 @@ int LSkipMgr::Open(const cppstring &filename)
 
 	libusbNumDevices = libusb_get_device_list(pGoIO_libusbContext, &libusbDeviceList);
 
-	m_pQueueAccessMutex = GThread::OSCreateMutex(GSTD_S(""));  
-
-	if (m_pMesBuf && m_pCmdBuf && m_pQueueAccessMutex)
+	if (m_pMesBuf && m_pCmdBuf)
 	{
 		// Get pointer to dev again from string
 		libusb_device *dev = NULL;
@@ -319,17 +306,17 @@ int LSkipMgr::Open(const cppstring &filename)
 			nResult = kResponse_Error;
 
 		if (kResponse_OK == nResult)
-		{	
-			/*jentodo is it because the main thread loop is processing the reads and sleeping for 30ms that everything is so slow.*/
-			m_pMesBuf->SetQueueAccessMutex(m_pQueueAccessMutex);
-			m_pCmdBuf->SetQueueAccessMutex(m_pQueueAccessMutex);
-			m_pListeningThread = new GThread(((StdThreadFunctionPtr)LSkipMgr::gListenForResponse),
-						NULL, NULL, NULL, NULL, (void *) this, NULL, false);
-			if (!m_pListeningThread)
+		{
+			m_bHasEventThreadRef = gAddEventThreadRef();
+			if (!m_bHasEventThreadRef)
 				nResult = kResponse_Error;
 			else
-			if (!m_pListeningThread->OSStartThread())
-				nResult = kResponse_Error;
+			{
+				pthread_mutex_lock(&g_openMgrsMutex);
+				g_openMgrs.push_back(this);
+				pthread_mutex_unlock(&g_openMgrsMutex);
+				nResult = SubmitInTransfers();
+			}
 		}
 	}
 	else
@@ -343,23 +330,44 @@ int LSkipMgr::Open(const cppstring &filename)
 
 int LSkipMgr::Close()
 {
+	//Take this device off the event thread's back-pressure tick, and forget any parked transfers. libusb does not
+	//own those, so there is nothing to reap for them.
+	pthread_mutex_lock(&g_openMgrsMutex);
+	std::vector<LSkipMgr *>::iterator iter = std::find(g_openMgrs.begin(), g_openMgrs.end(), this);
+	if (iter != g_openMgrs.end())
+		g_openMgrs.erase(iter);
+	pthread_mutex_unlock(&g_openMgrsMutex);
+
+	m_backPressure.Lock();
 	m_stayAlive = false;
-    	if (m_pListeningThread)
-   	{
-    		delete m_pListeningThread;
-    		m_pListeningThread = NULL;
-   	}
-
-	if (m_pMesBuf)
-		m_pMesBuf->SetQueueAccessMutex(NULL);
-
-	if (m_pCmdBuf)
-		m_pCmdBuf->SetQueueAccessMutex(NULL);
+	m_nNumParkedTransfers = 0;
+	m_backPressure.Unlock();
+
+	//Reap every cancelled transfer before the handle is closed. gInTransferComplete() dereferences this object, so
+	//neither the handle nor this object may go away while libusb still owns a transfer: keep going until they are
+	//all back, however long that takes. The shared event thread may be reaping them at the same time, libusb
+	//serializes that for us.
+	unsigned int startTimeMs = GUtils::OSGetTimeStamp();
+	bool bReportedSlowCancel = false;
+	while (m_nInTransfersInFlight > 0)
+	{
+		struct timeval tv;
+		tv.tv_sec = 0;
+		tv.tv_usec = 10000;
+		CancelInTransfers();
+		libusb_handle_events_timeout_completed(pGoIO_libusbContext, &tv, NULL);
+		if ((!bReportedSlowCancel) && ((GUtils::OSGetTimeStamp() - startTimeMs) > 1000))
+		{
+			printf("Warning: still waiting for %d IN transfers on %p to be cancelled.\n", m_nInTransfersInFlight, m_hDeviceFile);
+			bReportedSlowCancel = true;
+		}
+	}
+	FreeInTransfers();
 
-	if (m_pQueueAccessMutex)
+	if (m_bHasEventThreadRef)
 	{
-		GThread::OSDestroyMutex(m_pQueueAccessMutex);
-		m_pQueueAccessMutex = NULL;
+		gReleaseEventThreadRef();
+		m_bHasEventThreadRef = false;
 	}
 
 	if (NULL != m_hDeviceFile)
@@ -372,69 +380,276 @@ int LSkipMgr::Close()
 	return kResponse_OK;
 }
 
-int LSkipMgr::gListenForResponse(void *pParam)
+void LSkipMgr::AddPacket(unsigned char *pBuf)
+{
+	//Add packet to appropriate queue.
+	if ((pBuf[0] & SKIP_MASK_INPUT_PACKET_TYPE))
+	{
+		if (NULL != m_pCmdBuf)
+		{
+			m_pCmdBuf->AddRec((GSkipPacket *) pBuf);
+			SignalCmdRespPackets();
+		}
+	}
+	else
+	if (NULL != m_pMesBuf)
+	{
+		//Decode the measurements right away, so the reader just copies them out.
+		int measurements[SKIP_MAX_MEASUREMENTS_IN_PACKET];
+		unsigned char sequenceNumbers[SKIP_MAX_MEASUREMENTS_IN_PACKET];
+		unsigned long long timestamps[SKIP_MAX_MEASUREMENTS_IN_PACKET];
+		unsigned long long nArrivalTimeNs = LSkipGetMonotonicTimeNs();
+		int nNumInPacket;
+		int nNumMeasurements = m_pDecodeMeasurementPackets((GSkipPacket *) pBuf, 1, measurements, sequenceNumbers, &nNumInPacket);
+		for (int i = 0; i < nNumMeasurements; i++)
+			timestamps[i] = nArrivalTimeNs;
+		if (nNumMeasurements > 0)
+		{
+			__atomic_store_n(&m_nNumMeasurementsInLastPacket, nNumMeasurements, __ATOMIC_RELAXED);
+			m_latestMeasurement.Publish(measurements[nNumMeasurements - 1], nArrivalTimeNs);
+		}
+		m_pMesBuf->AddRecs(measurements, nNumMeasurements, sequenceNumbers, timestamps);
+	}
+}
+
+int LSkipMgr::SubmitInTransfers()
 {
 	int nResult = kResponse_OK;
-	LSkipMgr *pMgr = (LSkipMgr *)pParam;
 
-	if (NULL != pMgr)
+	if (NULL == m_pInTransfers)
 	{
-		while (NULL != pMgr->m_hDeviceFile)	
+		m_pInTransfers = new struct libusb_transfer *[m_nNumInTransfers];
+		m_pParkedTransfers = new struct libusb_transfer *[m_nNumInTransfers];
+		m_pInTransferBufs = new unsigned char[m_nNumInTransfers*sizeof(GSkipPacket)];
+		memset(m_pInTransferBufs, 0, m_nNumInTransfers*sizeof(GSkipPacket));
+		for (int ix = 0; ix < m_nNumInTransfers; ix++)
+			m_pInTransfers[ix] = libusb_alloc_transfer(0);
+	}
+
+	for (int ix = 0; ix < m_nNumInTransfers; ix++)
+	{
+		struct libusb_transfer *pTransfer = m_pInTransfers[ix];
+		if (NULL == pTransfer)
 		{
-			unsigned char buf[8];
-			int bytesReceived;
+			nResult = kResponse_Error;
+			break;
+		}
 
-			int ret = -999;
+		//Reports are always 8 bytes, so each transfer completes as soon as the device sends one.
+		//No timeout is needed since Close() cancels the transfers explicitly.
+		libusb_fill_interrupt_transfer(pTransfer, m_hDeviceFile, /*Endpoint:*/0x81, 
+			m_pInTransferBufs + ix*sizeof(GSkipPacket), sizeof(GSkipPacket), LSkipMgr::gInTransferComplete, (void *) this, /*Timeout:*/0);
+		__sync_fetch_and_add(&m_nInTransfersInFlight, 1);
+		int ret = libusb_submit_transfer(pTransfer);
+		if (0 != ret)
+		{
+			__sync_fetch_and_sub(&m_nInTransfersInFlight, 1);
+			printf("Failed to submit IN transfer %d on %p (error %d)\n", ix, m_hDeviceFile, ret);
+			nResult = kResponse_Error;
+			break;
+		}
+	}
 
-			if (NULL != pMgr->m_hDeviceFile)
-				ret = libusb_interrupt_transfer(pMgr->m_hDeviceFile, /*Endpoint:*/0x81, buf, sizeof(buf), &bytesReceived, /*Timeout*/100); // can't use infinite timeout -- glib pthread_kill no longer signals
+	return nResult;
+}
 
-			if (0 == ret)
-			{ // Success
-				//Add packet to appropriate queue.
-				if ((buf[0] & SKIP_MASK_INPUT_PACKET_TYPE))
-				{
-					if (NULL != pMgr->m_pCmdBuf)
-						pMgr->m_pCmdBuf->AddRec((GSkipPacket *) (&buf[0]));
-				}
-				else
-				if (NULL != pMgr->m_pMesBuf)
-				{
-					pMgr->m_pMesBuf->AddRec((GSkipPacket *) (&buf[0]));
-					GSkipMeasurementPacket *pMeasRec = (GSkipMeasurementPacket *) (&buf[0]);
-					pMgr->m_lastNumMeasurementsInPacket = pMeasRec->nMeasurementsInPacket;
-				}
-			}
+void LSkipMgr::CancelInTransfers()
+{
+	//Cancelling a transfer that is not currently submitted just returns LIBUSB_ERROR_NOT_FOUND, so it is safe to cancel them all.
+	if (NULL != m_pInTransfers)
+	{
+		for (int ix = 0; ix < m_nNumInTransfers; ix++)
+		{
+			if (NULL != m_pInTransfers[ix])
+				libusb_cancel_transfer(m_pInTransfers[ix]);
+		}
+	}
+}
+
+void LSkipMgr::FreeInTransfers()
+{
+	//Transfers that libusb still owns cannot be freed. Close() reaps them all first.
+	GSTD_ASSERT(0 == m_nInTransfersInFlight);
+	if ((NULL != m_pInTransfers) && (0 == m_nInTransfersInFlight))
+	{
+		for (int ix = 0; ix < m_nNumInTransfers; ix++)
+		{
+			if (NULL != m_pInTransfers[ix])
+				libusb_free_transfer(m_pInTransfers[ix]);
+		}
+		delete [] m_pInTransfers;
+		m_pInTransfers = NULL;
+		delete [] m_pInTransferBufs;
+		m_pInTransferBufs = NULL;
+		delete [] m_pParkedTransfers;
+		m_pParkedTransfers = NULL;
+		m_nNumParkedTransfers = 0;
+	}
+}
+
+void LSkipMgr::ResumeInTransfers()
+{
+	//Caller holds m_backPressure's lock.
+	while (m_stayAlive && (m_nNumParkedTransfers > 0))
+	{
+		struct libusb_transfer *pTransfer = m_pParkedTransfers[--m_nNumParkedTransfers];
+		__sync_fetch_and_add(&m_nInTransfersInFlight, 1);
+		int ret = libusb_submit_transfer(pTransfer);
+		if (0 != ret)
+		{
+			__sync_fetch_and_sub(&m_nInTransfersInFlight, 1);
+			printf("Error (%d): Resubmitting IN transfer on %p\n", ret, m_hDeviceFile);
+		}
+	}
+}
+
+void LSkipMgr::ReleaseBackPressure()
+{
+	//Called by the consumer after it has taken measurements out of the queue, or changed the queue.
+	m_backPressure.Lock();
+	if (m_backPressure.ShouldResume(m_pMesBuf, GetBackPressureHeadroom()))
+		ResumeInTransfers();
+	m_backPressure.Unlock();
+}
+
+void LIBUSB_CALL LSkipMgr::gInTransferComplete(struct libusb_transfer *pTransfer)
+{
+	LSkipMgr *pMgr = (LSkipMgr *) pTransfer->user_data;
+	bool bResubmit = false;
+	bool bSubmitted = false;
+
+	switch (pTransfer->status)
+	{
+		case LIBUSB_TRANSFER_COMPLETED:
+			if (pTransfer->actual_length > 0)
+				pMgr->AddPacket(pTransfer->buffer);
+			bResubmit = true;
+			break;
+		case LIBUSB_TRANSFER_TIMED_OUT:
+			bResubmit = true;
+			break;
+		case LIBUSB_TRANSFER_CANCELLED:
+			break;
+		default:
+			printf("Error (%d): Reading from %p\n", pTransfer->status, pMgr->m_hDeviceFile);
+			break;
+	}
+
+	//Put the transfer straight back in the ring so the device always has somewhere to send the next report, unless
+	//the measurement queue is running out of room under kPacketQueueOverflow_BlockProducer. Then park it until the
+	//consumer makes room(ReleaseBackPressure()) or the block timeout runs out(gResumeExpiredPauses()).
+	if (bResubmit)
+	{
+		pMgr->m_backPressure.Lock();
+		if (pMgr->m_stayAlive)
+		{
+			if (pMgr->m_backPressure.ShouldPause(pMgr->m_pMesBuf, pMgr->GetBackPressureHeadroom()))
+				pMgr->m_pParkedTransfers[pMgr->m_nNumParkedTransfers++] = pTransfer;
 			else
-			{ // Error
-				if (!pMgr->m_stayAlive || (LIBUSB_ERROR_TIMEOUT != ret))
-				{ // timeouts are handled here -- just keep looping and reading
-					if (LIBUSB_ERROR_TIMEOUT != ret)
-						printf("Error (%d): Reading from %p\n", ret, pMgr->m_hDeviceFile);
-					break;
-				}
+			{
+				int ret = libusb_submit_transfer(pTransfer);
+				if (0 == ret)
+					bSubmitted = true;
+				else
+					printf("Error (%d): Resubmitting IN transfer on %p\n", ret, pMgr->m_hDeviceFile);
 			}
 		}
+		pMgr->m_backPressure.Unlock();
 	}
 
-	return nResult;
+	if (!bSubmitted)
+		__sync_fetch_and_sub(&pMgr->m_nInTransfersInFlight, 1);
 }
 
-/*
+static pthread_mutex_t g_eventThreadMutex = PTHREAD_MUTEX_INITIALIZER;
+static GThread *g_pEventThread = NULL;
+static int g_nEventThreadRefs = 0;
+static volatile bool g_bEventThreadStop = false;
 
-int LSkipMgr::gExitThread(void *pParam)
+bool LSkipMgr::gResumeExpiredPauses()
 {
-	int nResult = kResponse_OK;
-	pthread_exit(NULL);
-	return nResult;
+	bool bAnyPaused = false;
+
+	pthread_mutex_lock(&g_openMgrsMutex);
+	for (std::vector<LSkipMgr *>::iterator iter = g_openMgrs.begin(); iter != g_openMgrs.end(); iter++)
+	{
+		LSkipMgr *pMgr = (*iter);
+		pMgr->m_backPressure.Lock();
+		if (pMgr->m_backPressure.ShouldResumeAfterTimeout())
+			pMgr->ResumeInTransfers();
+		if (pMgr->m_backPressure.IsPaused())
+			bAnyPaused = true;
+		pMgr->m_backPressure.Unlock();
+	}
+	pthread_mutex_unlock(&g_openMgrsMutex);
+
+	return bAnyPaused;
 }
 
-int LSkipMgr::gStartThread(void *pParam)
+bool LSkipMgr::gAddEventThreadRef()
 {
-	return kResponse_OK;
+	bool bResult = true;
+
+	pthread_mutex_lock(&g_eventThreadMutex);
+	if (NULL == g_pEventThread)
+	{
+		g_bEventThreadStop = false;
+		g_pEventThread = new GThread(((StdThreadFunctionPtr)LSkipMgr::gHandleEvents),
+					NULL, NULL, NULL, NULL, NULL, NULL, false);
+		if (g_pEventThread && !g_pEventThread->OSStartThread())
+		{
+			delete g_pEventThread;
+			g_pEventThread = NULL;
+		}
+	}
+
+	if (NULL != g_pEventThread)
+		g_nEventThreadRefs++;
+	else
+		bResult = false;
+	pthread_mutex_unlock(&g_eventThreadMutex);
+
+	return bResult;
+}
+
+void LSkipMgr::gReleaseEventThreadRef()
+{
+	pthread_mutex_lock(&g_eventThreadMutex);
+	if (g_nEventThreadRefs > 0)
+		g_nEventThreadRefs--;
+	if ((0 == g_nEventThreadRefs) && (NULL != g_pEventThread))
+	{
+		g_bEventThreadStop = true;
+		delete g_pEventThread;//Waits for gHandleEvents() to return.
+		g_pEventThread = NULL;
+	}
+	pthread_mutex_unlock(&g_eventThreadMutex);
+}
+
+int LSkipMgr::gHandleEvents(void * /*pParam*/)
+{
+	int nResult = kResponse_OK;
+
+	//Completed transfers are routed and resubmitted by gInTransferComplete(), which libusb calls from in here
+	//for whichever device they belong to.
+	bool bAnyPaused = false;
+	while (!g_bEventThreadStop)
+	{
+		struct timeval tv;
+		tv.tv_sec = 0;
+		tv.tv_usec = bAnyPaused ? 10000 : 100000; // can't use infinite timeout -- glib pthread_kill no longer signals
+		int ret = libusb_handle_events_timeout_completed(pGoIO_libusbContext, &tv, NULL);
+		if ((0 != ret) && (LIBUSB_ERROR_INTERRUPTED != ret))
+		{
+			printf("Error (%d): Handling libusb events\n", ret);
+			break;
+		}
+		bAnyPaused = gResumeExpiredPauses();
+	}
+
+	return nResult;
 }
 
-*/
 bool GSkipBaseDevice::OSInitialize(void)
 {
 	bool bResult = true;
@@ -442,11 +657,239 @@ bool GSkipBaseDevice::OSInitialize(void)
 	return bResult;
 }
 
+//Process wide registry of attached Vernier devices, kept current by libusb hotplug events so that enumeration
+//does not have to rescan the bus. Falls back to libusb_get_device_list() if hotplug is not available.
+struct LSkipRegistryEntry
+{
+	int nVendorID;
+	int nProductID;
+	cppstring sDeviceName;
+};
+
+struct LSkipNotification
+{
+	LSkipRegistryEntry entry;
+	bool bArrived;
+};
+
+//Notifications are delivered by a thread of their own rather than the shared event thread, so the callback may
+//send commands to sensors, or open and close them, without stalling the IN transfers of every open device.
+struct LSkipNotifier
+{
+	GThread *pThread;
+	bool bStop;	//Guarded by g_registryMutex.
+};
+
+static pthread_mutex_t g_registryInitMutex = PTHREAD_MUTEX_INITIALIZER;//Serializes creation/release of the registry and the notifier.
+static pthread_mutex_t g_registryMutex = PTHREAD_MUTEX_INITIALIZER;//Protects g_registry, the notification queue and the notification callback.
+static pthread_cond_t g_notificationCond = PTHREAD_COND_INITIALIZER;//Signalled when a notification is queued or the notifier should stop.
+static std::vector<LSkipRegistryEntry> g_registry;
+static std::vector<LSkipNotification> g_notifications;
+static bool g_bRegistryActive = false;
+static bool g_bRegistryUnavailable = false;
+static libusb_hotplug_callback_handle g_hHotplugCallback;
+static GSkipBaseDevice::DeviceNotificationFunctionPtr g_pDeviceNotificationFunction = NULL;
+static void *g_pDeviceNotificationContext = NULL;
+static LSkipNotifier *g_pNotifier = NULL;
+
+static int LIBUSB_CALL local_HotplugCallback(libusb_context * /*ctx*/, libusb_device *dev, libusb_hotplug_event event, void * /*pUserData*/)
+{
+	struct libusb_device_descriptor devDesc;
+	if (0 != libusb_get_device_descriptor(dev, &devDesc))
+		return 0;
+
+	LSkipRegistryEntry entry;
+	entry.nVendorID = devDesc.idVendor;
+	entry.nProductID = devDesc.idProduct;
+	entry.sDeviceName = local_BusAndAddressToCPPStringw(libusb_get_bus_number(dev), libusb_get_device_address(dev));
+	bool bArrived = (LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED == event);
+
+	pthread_mutex_lock(&g_registryMutex);
+	std::vector<LSkipRegistryEntry>::iterator iter = g_registry.begin();
+	while (iter != g_registry.end())
+	{
+		if (iter->sDeviceName == entry.sDeviceName)
+			iter = g_registry.erase(iter);
+		else
+			iter++;
+	}
+	if (bArrived)
+		g_registry.push_back(entry);
+	if (NULL != g_pDeviceNotificationFunction)
+	{
+		LSkipNotification notification;
+		notification.entry = entry;
+		notification.bArrived = bArrived;
+		g_notifications.push_back(notification);
+		pthread_cond_signal(&g_notificationCond);
+	}
+	pthread_mutex_unlock(&g_registryMutex);
+
+	return 0;//Stay registered.
+}
+
+static int local_DeliverNotifications(void *pParam)
+{
+	LSkipNotifier *pNotifier = (LSkipNotifier *) pParam;
+
+	//The callback is called without any lock held, so it may make any GoIO call except GoIO_Uninit().
+	pthread_mutex_lock(&g_registryMutex);
+	while (!pNotifier->bStop)
+	{
+		if (g_notifications.empty())
+		{
+			pthread_cond_wait(&g_notificationCond, &g_registryMutex);
+			continue;
+		}
+
+		LSkipNotification notification = g_notifications.front();
+		g_notifications.erase(g_notifications.begin());
+		GSkipBaseDevice::DeviceNotificationFunctionPtr pFunction = g_pDeviceNotificationFunction;
+		void *pContext = g_pDeviceNotificationContext;
+		pthread_mutex_unlock(&g_registryMutex);
+
+		if (NULL != pFunction)
+			pFunction(notification.entry.nVendorID, notification.entry.nProductID, notification.entry.sDeviceName, notification.bArrived, pContext);
+
+		pthread_mutex_lock(&g_registryMutex);
+	}
+	pthread_mutex_unlock(&g_registryMutex);
+
+	return kResponse_OK;
+}
+
+//Caller holds g_registryInitMutex.
+static bool local_StartNotifier()
+{
+	if (NULL == g_pNotifier)
+	{
+		LSkipNotifier *pNotifier = new LSkipNotifier;
+		pNotifier->bStop = false;
+		pNotifier->pThread = new GThread(((StdThreadFunctionPtr)local_DeliverNotifications),
+					NULL, NULL, NULL, NULL, (void *) pNotifier, NULL, false);
+		if (pNotifier->pThread && pNotifier->pThread->OSStartThread())
+			g_pNotifier = pNotifier;
+		else
+		{
+			delete pNotifier->pThread;
+			delete pNotifier;
+		}
+	}
+
+	return (NULL != g_pNotifier);
+}
+
+//Returns true if the registry is being maintained by hotplug events.
+static bool local_StartDeviceRegistry()
+{
+	pthread_mutex_lock(&g_registryInitMutex);
+	if ((!g_bRegistryActive) && (!g_bRegistryUnavailable) && (NULL != pGoIO_libusbContext))
+	{
+		if (!libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG))
+			g_bRegistryUnavailable = true;
+		else
+		if (LSkipMgr::gAddEventThreadRef())//Hotplug callbacks are delivered by the shared event thread.
+		{
+			//LIBUSB_HOTPLUG_ENUMERATE reports the devices that are already attached before this call returns.
+			int ret = libusb_hotplug_register_callback(pGoIO_libusbContext, 
+				(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT), LIBUSB_HOTPLUG_ENUMERATE,
+				VERNIER_DEFAULT_VENDOR_ID, LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY, 
+				local_HotplugCallback, NULL, &g_hHotplugCallback);
+			if (0 == ret)
+				g_bRegistryActive = true;
+			else
+			{
+				printf("Unable to register hotplug callback (error %d)\n", ret);
+				g_bRegistryUnavailable = true;
+				LSkipMgr::gReleaseEventThreadRef();
+			}
+		}
+	}
+	bool bActive = g_bRegistryActive;
+	pthread_mutex_unlock(&g_registryInitMutex);
+
+	return bActive;
+}
+
+void GSkipBaseDevice::OSReleaseDeviceRegistry(void)
+{
+	pthread_mutex_lock(&g_registryInitMutex);
+	if (g_bRegistryActive)
+	{
+		libusb_hotplug_deregister_callback(pGoIO_libusbContext, g_hHotplugCallback);
+		LSkipMgr::gReleaseEventThreadRef();
+		g_bRegistryActive = false;
+	}
+	g_bRegistryUnavailable = false;
+
+	LSkipNotifier *pNotifier = g_pNotifier;
+	g_pNotifier = NULL;
+	pthread_mutex_lock(&g_registryMutex);
+	g_registry.clear();
+	g_notifications.clear();
+	g_pDeviceNotificationFunction = NULL;
+	g_pDeviceNotificationContext = NULL;
+	if (NULL != pNotifier)
+	{
+		pNotifier->bStop = true;
+		pthread_cond_broadcast(&g_notificationCond);
+	}
+	pthread_mutex_unlock(&g_registryMutex);
+	pthread_mutex_unlock(&g_registryInitMutex);
+
+	//Wait for the notifier outside the locks, a callback that is still running may be using the registry.
+	if (NULL != pNotifier)
+	{
+		delete pNotifier->pThread;//Waits for local_DeliverNotifications() to return.
+		delete pNotifier;
+	}
+}
+
+int GSkipBaseDevice::OSSetDeviceNotificationCallback(DeviceNotificationFunctionPtr pFunction, void *pContext)
+{
+	int nResult = kResponse_Error;
+
+	bool bReady = (NULL == pFunction);
+	if ((!bReady) && local_StartDeviceRegistry())
+	{
+		pthread_mutex_lock(&g_registryInitMutex);
+		bReady = local_StartNotifier();
+		pthread_mutex_unlock(&g_registryInitMutex);
+	}
+
+	if (bReady)
+	{
+		pthread_mutex_lock(&g_registryMutex);
+		g_pDeviceNotificationFunction = pFunction;
+		g_pDeviceNotificationContext = pContext;
+		if (NULL == pFunction)
+			g_notifications.clear();
+		pthread_mutex_unlock(&g_registryMutex);
+		nResult = kResponse_OK;
+	}
+
+	return nResult;
+}
+
 StringVector GSkipBaseDevice::OSGetAvailableDevicesOfType(
 	int nVendorID, 	// Vendor ID (e.g. VERNIER_DEFAULT_VENDOR_ID)
 	int nProductID)	// Product ID (e.g. USB_DIRECT_TEMP_DEFAULT_PRODUCT_ID)
 {
 	StringVector vPortNames;
+
+	if ((VERNIER_DEFAULT_VENDOR_ID == nVendorID) && local_StartDeviceRegistry())
+	{
+		pthread_mutex_lock(&g_registryMutex);
+		for (size_t ix = 0; ix < g_registry.size(); ix++)
+		{
+			if (g_registry[ix].nProductID == nProductID)
+				vPortNames.push_back(g_registry[ix].sDeviceName);
+		}
+		pthread_mutex_unlock(&g_registryMutex);
+
+		return vPortNames;
+	}
+
 	libusb_device **libusbDeviceList;
 	int libusbNumDevices;            
 
@@ -487,6 +930,7 @@ int GSkipBaseDevice::OSOpen(GPortRef *pPortRef)
 	{
 		if (LockDevice(1) && IsOKToUse())
 		{
+			((LSkipMgr*)m_pOSData)->m_pDecodeMeasurementPackets = GetMeasurementPacketBatchDecoder();
 			((LSkipMgr*)m_pOSData)->Open(pPortRef->GetLocation());
 			nResult = kResponse_OK;
 			UnlockDevice();
@@ -520,39 +964,44 @@ void GSkipBaseDevice::OSDestroy(void)
 }
 
 int GSkipBaseDevice::OSReadMeasurementPackets(
-	void * pBuffer, //[out] ptr to destination buffer
+	void * /*pBuffer*/, //[out] ptr to destination buffer
 	int * pIONumPackets, //[in, out] number of packets desired on input, number of packets read on output
-	int nBufferSizeInPackets) //[in] size of destination buffer in packets
+	int /*nBufferSizeInPackets*/) //[in] size of destination buffer in packets
+{
+	//Not used - the listener queues decoded measurements rather than packets, see OSReadMeasurements().
+	(*pIONumPackets) = 0;
+	return kResponse_Error;
+}
+
+int GSkipBaseDevice::OSReadMeasurements(
+	int * pMeasurements, //[out] ptr to destination buffer
+	unsigned char * pSequenceNumbers, //[out] ptr to destination buffer for the sequence numbers of the measurements
+	unsigned long long * pTimestampsNs, //[out] ptr to destination buffer for the arrival times of the measurements, may be NULL
+	int * pIONumMeasurements, //[in, out] number of measurements desired on input, number of measurements read on output
+	int nBufferSizeInMeasurements, //[in] size of destination buffers in measurements
+	unsigned char *pNumMeasurementsInLastPacket) //[out] number of measurements in the most recent packet
 {
 	int nResult = kResponse_Error;
-	int nPacketsRead = 0;
+	int nMeasurementsRead = 0;
 	if (NULL != m_pOSData)
 	{
 		LSkipMgr *pSkipMgr = (LSkipMgr *) m_pOSData;
-		unsigned char *pBuf = (unsigned char *) pBuffer;
-		int nPacketsDesired = (*pIONumPackets);
-		if (nPacketsDesired > nBufferSizeInPackets)
-			nPacketsDesired = nBufferSizeInPackets;
+		int nMeasurementsDesired = (*pIONumMeasurements);
+		if (nMeasurementsDesired > nBufferSizeInMeasurements)
+			nMeasurementsDesired = nBufferSizeInMeasurements;
 
 		if (LockDevice(1) && IsOKToUse())
 		{
 			nResult = kResponse_OK;
-			while (nPacketsRead < nPacketsDesired)
-			{
-				if (pSkipMgr->m_pMesBuf->RetrieveRec((GSkipPacket *) pBuf))
-				{
-					nPacketsRead++;
-					pBuf += sizeof(GSkipPacket);
-				}
-				else
-					break;
-			}
+			nMeasurementsRead = pSkipMgr->m_pMesBuf->RetrieveRecs(pMeasurements, nMeasurementsDesired, pSequenceNumbers, pTimestampsNs);
+			pSkipMgr->ReleaseBackPressure();
+			(*pNumMeasurementsInLastPacket) = (unsigned char) __atomic_load_n(&pSkipMgr->m_nNumMeasurementsInLastPacket, __ATOMIC_RELAXED);
 
 			UnlockDevice();
 		}
 	}
 
-	(*pIONumPackets) = nPacketsRead;
+	(*pIONumMeasurements) = nMeasurementsRead;
 	return nResult;
 }
 
@@ -566,7 +1015,6 @@ int GSkipBaseDevice::OSReadCmdRespPackets(
 	if (NULL != m_pOSData)
 	{
 		LSkipMgr *pSkipMgr = (LSkipMgr *) m_pOSData;
-		unsigned char *pBuf = (unsigned char *) pBuffer;
 		int nPacketsDesired = (*pIONumPackets);
 		if (nPacketsDesired > nBufferSizeInPackets)
 			nPacketsDesired = nBufferSizeInPackets;
@@ -574,16 +1022,7 @@ int GSkipBaseDevice::OSReadCmdRespPackets(
 		if (LockDevice(1) && IsOKToUse())
 		{
 			nResult = kResponse_OK;
-			while (nPacketsRead < nPacketsDesired)
-			{
-				if (pSkipMgr->m_pCmdBuf->RetrieveRec((GSkipPacket *) pBuf))
-				{
-					nPacketsRead++;
-					pBuf += sizeof(GSkipPacket);
-				}
-				else
-					break;
-			}
+			nPacketsRead = pSkipMgr->m_pCmdBuf->RetrieveRecs((GSkipPacket *) pBuffer, nPacketsDesired);
 
 			UnlockDevice();
 		}
@@ -634,11 +1073,11 @@ int GSkipBaseDevice::OSMeasurementPacketsAvailable(unsigned char *pNumMeasuremen
 {
 	int nReturn = 0;
 
+	//The queue holds decoded measurements, so report them as 1 measurement per packet.
 	(*pNumMeasurementsInLastPacket) = 1;
 
 	if (m_pOSData && LockDevice(1) && IsOKToUse())
 	{
-		(*pNumMeasurementsInLastPacket) = ((LSkipMgr*)m_pOSData)->m_lastNumMeasurementsInPacket;
 		if (((LSkipMgr*)m_pOSData)->m_pMesBuf)
 			nReturn = ((LSkipMgr*)m_pOSData)->m_pMesBuf->NumRecsAvailable();
 
@@ -661,6 +1100,18 @@ int GSkipBaseDevice::OSCmdRespPacketsAvailable(void)
 	return nReturn;
 }
 
+int GSkipBaseDevice::OSWaitForCmdRespPackets(int nTimeoutMs)
+{
+	int nReturn = 0;
+
+	if (m_pOSData && LockDevice(1) && IsOKToUse())
+	{
+		nReturn = ((LSkipMgr*)m_pOSData)->WaitForCmdRespPackets(nTimeoutMs);
+		UnlockDevice();
+	}
+	return nReturn;
+}
+
 int GSkipBaseDevice::OSClearMeasurementPacketQueue()
 {
 	int nResult = kResponse_Error;
@@ -670,7 +1121,7 @@ int GSkipBaseDevice::OSClearMeasurementPacketQueue()
 		if (LockDevice(1) && IsOKToUse())
 		{
 			((LSkipMgr*)m_pOSData)->m_pMesBuf->Clear();
-			((LSkipMgr*)m_pOSData)->m_lastNumMeasurementsInPacket = 0;
+			((LSkipMgr*)m_pOSData)->ReleaseBackPressure();
 			nResult = kResponse_OK;
 			UnlockDevice();
 		}
@@ -696,6 +1147,80 @@ int GSkipBaseDevice::OSClearCmdRespPacketQueue()
 	return nResult;
 }
 
+int GSkipBaseDevice::OSSetMeasurementQueueOptions(int nCapacity, int nOverflowPolicy, int nBlockTimeoutMs)
+{
+	int nResult = kResponse_Error;
+
+	if (m_pOSData && (nCapacity > 0) && (nBlockTimeoutMs >= 0) &&
+		(nOverflowPolicy >= kPacketQueueOverflow_DropOldest) && (nOverflowPolicy <= kPacketQueueOverflow_BlockProducer))
+	{
+		if (LockDevice(1) && IsOKToUse())
+		{
+			LSkipMgr *pSkipMgr = (LSkipMgr *) m_pOSData;
+			pSkipMgr->m_pMesBuf->SetOptions(nCapacity, nOverflowPolicy, nBlockTimeoutMs);
+			pSkipMgr->m_backPressure.Lock();
+			pSkipMgr->m_backPressure.SetOptions(nOverflowPolicy, nBlockTimeoutMs);
+			pSkipMgr->m_backPressure.Unlock();
+			pSkipMgr->ReleaseBackPressure();
+			nResult = kResponse_OK;
+			UnlockDevice();
+		}
+	}
+
+	return nResult;
+}
+
+int GSkipBaseDevice::OSGetMeasurementQueueOverflowCount(unsigned int *pNumDropped)
+{
+	int nResult = kResponse_Error;
+
+	if (m_pOSData)
+	{
+		if (LockDevice(1) && IsOKToUse())
+		{
+			(*pNumDropped) = ((LSkipMgr*)m_pOSData)->m_pMesBuf->GetNumRecsDropped();
+			nResult = kResponse_OK;
+			UnlockDevice();
+		}
+	}
+
+	return nResult;
+}
+
+int GSkipBaseDevice::OSPeekLatestMeasurement(int *pMeasurement, unsigned long long *pTimestampNs)
+{
+	int nResult = kResponse_Error;
+
+	//No device lock, the register is safe to read while another thread drains the queue.
+	if (m_pOSData && ((LSkipMgr*)m_pOSData)->m_latestMeasurement.Peek(pMeasurement, pTimestampNs))
+		nResult = kResponse_OK;
+
+	return nResult;
+}
+
+int GSkipBaseDevice::OSCopyRecentMeasurements(
+	int * pMeasurements, //[out] ptr to destination buffer
+	unsigned long long * pTimestampsNs, //[out] ptr to destination buffer for the arrival times, may be NULL
+	int * pIONumMeasurements) //[in, out] size of destination buffers on input, number of measurements copied on output
+{
+	int nResult = kResponse_Error;
+	int nMeasurementsCopied = 0;
+
+	if (m_pOSData)
+	{
+		//The device lock keeps Clear() and SetOptions() out while we copy.
+		if (LockDevice(1) && IsOKToUse())
+		{
+			nMeasurementsCopied = ((LSkipMgr*)m_pOSData)->m_pMesBuf->CopyNewestRecs(pMeasurements, (*pIONumMeasurements), pTimestampsNs);
+			nResult = kResponse_OK;
+			UnlockDevice();
+		}
+	}
+
+	(*pIONumMeasurements) = nMeasurementsCopied;
+	return nResult;
+}
+
 int GSkipBaseDevice::OSClearIO(void)
 {
 	int nResult = kResponse_OK;
@@ -0,0 +1,522 @@
+/*********************************************************************************
+
+Copyright (c) 2010, Vernier Software & Technology
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Vernier Software & Technology nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL VERNIER SOFTWARE & TECHNOLOGY BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+// LSkipRing.h
+//
+// Queues shared by the Linux backends. Exactly one thread adds records(the listener) and only the thread that
+// holds the device lock removes them, so each queue is a lock free single producer/single consumer ring.
+// The producer never waits for the consumer: when the ring is full it drops the oldest record, just like the mutex based
+// circular buffer this replaced, or the newest one under kPacketQueueOverflow_DropNewest. SetOptions() selects the
+// overflow policy or resizes the ring.
+//
+// kPacketQueueOverflow_BlockProducer is not handled by the ring, which treats it like kPacketQueueOverflow_DropOldest.
+// The listener thread is shared by every open device, so it can not wait for one device's consumer. LSkipBackPressure
+// tells the listener to stop reading from a device instead, until its consumer has made room or the block timeout runs out.
+//
+// LSkipPacketRing holds raw packets(command responses). LSkipSampleRing holds measurements that the listener has
+// already decoded, each tagged with its sequence number(the nRollingCounter of the packet it came from plus its
+// index in that packet) and the CLOCK_MONOTONIC time in nanoseconds at which the listener received the packet.
+
+#ifndef _LSKIPRING_H_
+#define _LSKIPRING_H_
+
+#include "GSkipComm.h"
+#include "GSkipBaseDevice.h"
+#include "GUtils.h"
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#define LSKIP_CACHE_LINE_SIZE 64
+
+#define LSKIP_DEFAULT_NUM_QUEUED_PACKETS 2000
+#define LSKIP_DEFAULT_NUM_QUEUED_MEASUREMENTS (LSKIP_DEFAULT_NUM_QUEUED_PACKETS*SKIP_MAX_MEASUREMENTS_IN_PACKET)
+
+#ifdef LIB_NAMESPACE
+namespace LIB_NAMESPACE {
+#endif
+
+inline unsigned long long LSkipGetMonotonicTimeNs()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((unsigned long long) now.tv_sec)*1000000000ULL + now.tv_nsec;
+}
+
+template <class T>
+class LSkipRing
+{
+public:
+	LSkipRing(int numRecs, bool bKeepTags = false, bool bKeepTimestamps = false, 
+		int nOverflowPolicy = kPacketQueueOverflow_DropOldest, int nBlockTimeoutMs = 0);
+	~LSkipRing();
+
+	// Producer side. pTags and pTimestamps are ignored unless the ring was created with bKeepTags or bKeepTimestamps set:
+	void			AddRec(const T *pRec, unsigned char tag = 0) { AddRecs(pRec, 1, &tag); }
+	void			AddRecs(const T *pRecs, int nNumRecs, const unsigned char *pTags = NULL, const unsigned long long *pTimestamps = NULL);
+
+	// Consumer side:
+	bool			RetrieveRec(T *pRec);
+	//Returns # of records copied to pRecs.
+	int				RetrieveRecs(T *pRecs, int nMaxRecs, unsigned char *pTags = NULL, unsigned long long *pTimestamps = NULL);
+	//Copies up to nMaxRecs of the newest records, oldest first, without removing anything. Records that were already
+	//retrieved are included as long as their slots have not been reused. Returns # of records copied.
+	int				CopyNewestRecs(T *pRecs, int nMaxRecs, unsigned long long *pTimestamps = NULL);
+	void			Clear();
+	//Queued records are kept, newest first, as far as they fit. Waits for the producer to leave AddRecs().
+	void			SetOptions(int numRecs, int nOverflowPolicy, int nBlockTimeoutMs);
+
+	// Either side:
+	int				NumRecsAvailable();
+	int				NumRecsFree() { return GetCapacity() - NumRecsAvailable(); }
+	int				GetCapacity() { return (int) m_nCapacity; }
+	int				GetOverflowPolicy() { return m_nOverflowPolicy; }
+	int				GetBlockTimeoutMs() { return m_nBlockTimeoutMs; }
+	unsigned int	GetNumRecsDropped() { return __atomic_load_n(&m_nNumRecsDropped, __ATOMIC_RELAXED); }
+
+private:
+	void			Allocate(int numRecs);
+	void			DropOldestRec(unsigned int nFirstRec);
+	void			CountDroppedRec();
+	static void		CopyOut(void *pDest, const void *pSrc, unsigned int nFirstSlot, unsigned int nNumRecs, unsigned int nNumSlots, size_t nRecSize);
+
+	// Indices run freely and wrap at 2^32, the slot is (index & m_nMask).
+	// Only changed by SetOptions() while the producer is parked:
+	T				*m_pRecs;
+	unsigned char	*m_pTags;
+	bool			m_bKeepTags;
+	unsigned long long *m_pTimestamps;
+	bool			m_bKeepTimestamps;
+	unsigned int	m_nMask;
+	unsigned int	m_nCapacity;
+	int				m_nOverflowPolicy;
+	int				m_nBlockTimeoutMs;
+	bool			m_bResizing;
+	char			m_pad0[LSKIP_CACHE_LINE_SIZE];
+
+	// Written by the producer only:
+	unsigned int	m_nNextRec;
+	unsigned int	m_nNumRecsDropped;
+	bool			m_bProducerBusy;
+	char			m_pad1[LSKIP_CACHE_LINE_SIZE];
+
+	// Written by the consumer, and by the producer when it drops the oldest record:
+	unsigned int	m_nFirstRec;
+	// Written by the consumer only. Slots below this index hold nothing worth copying(cleared or from before a resize):
+	unsigned int	m_nHistoryFirstRec;
+	char			m_pad2[LSKIP_CACHE_LINE_SIZE];
+};
+
+typedef LSkipRing<GSkipPacket> LSkipPacketRing;
+typedef LSkipRing<int> LSkipSampleRing;
+
+// The most recent measurement decoded by the listener, with its arrival time. Written by the listener only and read
+// without taking the device lock or touching the measurement queue. The pair is kept consistent with a sequence lock:
+// the writer makes m_nSeq odd while it updates the pair, and a reader retries if m_nSeq was odd or changed under it.
+class LSkipLatestMeasurement
+{
+public:
+	LSkipLatestMeasurement() { m_nSeq = 0; m_nMeasurement = 0; m_nTimestampNs = 0; }
+
+	void Publish(int nMeasurement, unsigned long long nTimestampNs)
+	{
+		unsigned int nSeq = m_nSeq;
+		__atomic_store_n(&m_nSeq, nSeq + 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		__atomic_store_n(&m_nMeasurement, nMeasurement, __ATOMIC_RELAXED);
+		__atomic_store_n(&m_nTimestampNs, nTimestampNs, __ATOMIC_RELAXED);
+		__atomic_store_n(&m_nSeq, nSeq + 2, __ATOMIC_RELEASE);
+	}
+
+	//Returns false if nothing has been published yet.
+	bool Peek(int *pMeasurement, unsigned long long *pTimestampNs)
+	{
+		unsigned int nSeq1, nSeq2;
+		do
+		{
+			nSeq1 = __atomic_load_n(&m_nSeq, __ATOMIC_ACQUIRE);
+			(*pMeasurement) = __atomic_load_n(&m_nMeasurement, __ATOMIC_RELAXED);
+			(*pTimestampNs) = __atomic_load_n(&m_nTimestampNs, __ATOMIC_RELAXED);
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			nSeq2 = __atomic_load_n(&m_nSeq, __ATOMIC_RELAXED);
+		} while ((nSeq1 != nSeq2) || (nSeq1 & 1));
+
+		return (0 != nSeq1);
+	}
+
+private:
+	unsigned int		m_nSeq;
+	int					m_nMeasurement;
+	unsigned long long	m_nTimestampNs;
+};
+
+// Back-pressure for kPacketQueueOverflow_BlockProducer, one per device. The listener calls ShouldPause() after it has
+// queued measurements and stops reading from the device while it returns true. The consumer calls ShouldResume() after
+// it has removed measurements, and the listener calls ShouldResumeAfterTimeout() from its periodic tick. Only one caller
+// sees a given pause end, and that caller starts reading from the device again.
+// Callers hold Lock() around each call and around the pausing or resuming that follows it.
+class LSkipBackPressure
+{
+public:
+	LSkipBackPressure()
+	{
+		pthread_mutex_init(&m_mutex, NULL);
+		m_nOverflowPolicy = kPacketQueueOverflow_DropOldest;
+		m_nBlockTimeoutMs = 0;
+		m_bPaused = false;
+		m_bTimedOut = false;
+		m_nPauseStartMs = 0;
+	}
+	~LSkipBackPressure() { pthread_mutex_destroy(&m_mutex); }
+
+	void Lock() { pthread_mutex_lock(&m_mutex); }
+	void Unlock() { pthread_mutex_unlock(&m_mutex); }
+
+	void SetOptions(int nOverflowPolicy, int nBlockTimeoutMs)
+	{
+		m_nOverflowPolicy = nOverflowPolicy;
+		m_nBlockTimeoutMs = nBlockTimeoutMs;
+	}
+
+	//nHeadroom is the number of measurements that may still arrive after the listener stops reading.
+	//Returns true if the device is paused.
+	bool ShouldPause(LSkipSampleRing *pRing, int nHeadroom)
+	{
+		if ((!m_bPaused) && (!m_bTimedOut) && (kPacketQueueOverflow_BlockProducer == m_nOverflowPolicy) && (m_nBlockTimeoutMs > 0) && 
+			(pRing->NumRecsFree() < LimitHeadroom(pRing, nHeadroom)))
+		{
+			m_bPaused = true;
+			m_nPauseStartMs = GUtils::OSGetTimeStamp();
+		}
+		return m_bPaused;
+	}
+
+	//Returns true if the pause just ended. Once the consumer has made room, the block timeout applies afresh.
+	bool ShouldResume(LSkipSampleRing *pRing, int nHeadroom)
+	{
+		bool bResume = false;
+		if ((kPacketQueueOverflow_BlockProducer != m_nOverflowPolicy) || (pRing->NumRecsFree() >= LimitHeadroom(pRing, nHeadroom)))
+		{
+			bResume = m_bPaused;
+			m_bPaused = false;
+			m_bTimedOut = false;
+		}
+		return bResume;
+	}
+
+	//Returns true if the pause just ended. The ring drops the oldest measurements from then on, until the consumer makes room.
+	bool ShouldResumeAfterTimeout()
+	{
+		bool bResume = false;
+		if (m_bPaused && ((GUtils::OSGetTimeStamp() - m_nPauseStartMs) >= (unsigned int) m_nBlockTimeoutMs))
+		{
+			bResume = true;
+			m_bPaused = false;
+			m_bTimedOut = true;
+		}
+		return bResume;
+	}
+
+	bool IsPaused() { return m_bPaused; }
+
+private:
+	//A ring smaller than the headroom would never have enough room to resume on its own.
+	static int LimitHeadroom(LSkipSampleRing *pRing, int nHeadroom)
+	{
+		int nMaxHeadroom = pRing->GetCapacity()/2;
+		return (nHeadroom < nMaxHeadroom) ? nHeadroom : nMaxHeadroom;
+	}
+
+	pthread_mutex_t	m_mutex;
+	int				m_nOverflowPolicy;
+	int				m_nBlockTimeoutMs;
+	bool			m_bPaused;
+	bool			m_bTimedOut;
+	unsigned int	m_nPauseStartMs;
+};
+
+template <class T>
+inline LSkipRing<T>::LSkipRing(int numRecs, bool bKeepTags, bool bKeepTimestamps, int nOverflowPolicy, int nBlockTimeoutMs)
+{
+	m_bKeepTags = bKeepTags;
+	m_bKeepTimestamps = bKeepTimestamps;
+	Allocate(numRecs);
+	m_nOverflowPolicy = nOverflowPolicy;
+	m_nBlockTimeoutMs = nBlockTimeoutMs;
+	m_bResizing = false;
+	m_nNextRec = 0;
+	m_nNumRecsDropped = 0;
+	m_bProducerBusy = false;
+	m_nFirstRec = 0;
+	m_nHistoryFirstRec = 0;
+}
+
+template <class T>
+inline void LSkipRing<T>::Allocate(int numRecs)
+{
+	if (numRecs < 1)
+		numRecs = 1;
+	//Always leave at least one spare slot, so CopyNewestRecs() never copies the slot the producer is writing and
+	//a full ring is still less than a lap behind m_nNextRec.
+	unsigned int nNumSlots = 1;
+	while (nNumSlots <= (unsigned int) numRecs)
+		nNumSlots <<= 1;
+
+	m_pRecs = new T[nNumSlots];
+	m_pTags = m_bKeepTags ? new unsigned char[nNumSlots] : NULL;
+	m_pTimestamps = m_bKeepTimestamps ? new unsigned long long[nNumSlots] : NULL;
+	m_nMask = nNumSlots - 1;
+	m_nCapacity = numRecs;
+}
+
+template <class T>
+inline LSkipRing<T>::~LSkipRing()
+{
+	delete [] m_pRecs;
+	delete [] m_pTags;
+	delete [] m_pTimestamps;
+}
+
+template <class T>
+inline void LSkipRing<T>::CountDroppedRec()
+{
+	unsigned int nNumDropped = m_nNumRecsDropped + 1;
+	__atomic_store_n(&m_nNumRecsDropped, nNumDropped, __ATOMIC_RELAXED);
+	if (1 == (nNumDropped % m_nCapacity))
+		GSTD_TRACE("LSkipRing buffer overflowed.");
+}
+
+template <class T>
+inline void LSkipRing<T>::DropOldestRec(unsigned int nFirstRec)
+{
+	//If the CAS fails the consumer just took that record, and there is room now anyway.
+	if (__atomic_compare_exchange_n(&m_nFirstRec, &nFirstRec, nFirstRec + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		CountDroppedRec();
+}
+
+template <class T>
+inline void LSkipRing<T>::AddRecs(const T *pRecs, int nNumRecs, const unsigned char *pTags, const unsigned long long *pTimestamps)
+{
+	//m_bProducerBusy and m_bResizing form a handshake with SetOptions(), both sides store their own flag before
+	//loading the other one, so they can not both go ahead.
+	__atomic_store_n(&m_bProducerBusy, true, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&m_bResizing, __ATOMIC_SEQ_CST))
+	{
+		__atomic_store_n(&m_bProducerBusy, false, __ATOMIC_SEQ_CST);
+		while (__atomic_load_n(&m_bResizing, __ATOMIC_ACQUIRE))
+			GUtils::Sleep(1);
+		__atomic_store_n(&m_bProducerBusy, true, __ATOMIC_SEQ_CST);
+	}
+
+	unsigned int nNextRec = m_nNextRec;
+	for (int i = 0; i < nNumRecs; i++)
+	{
+		unsigned int nFirstRec = __atomic_load_n(&m_nFirstRec, __ATOMIC_ACQUIRE);
+		if ((nNextRec - nFirstRec) >= m_nCapacity)
+		{
+			if (kPacketQueueOverflow_DropNewest == m_nOverflowPolicy)
+			{
+				CountDroppedRec();
+				continue;
+			}
+
+			DropOldestRec(nFirstRec);
+		}
+
+		m_pRecs[nNextRec & m_nMask] = pRecs[i];
+		if (m_pTags)
+			m_pTags[nNextRec & m_nMask] = pTags ? pTags[i] : 0;
+		if (m_pTimestamps)
+			m_pTimestamps[nNextRec & m_nMask] = pTimestamps ? pTimestamps[i] : 0;
+		nNextRec++;
+		//Publish each record separately, so m_nFirstRec can never pass the published m_nNextRec.
+		__atomic_store_n(&m_nNextRec, nNextRec, __ATOMIC_RELEASE);
+	}
+
+	__atomic_store_n(&m_bProducerBusy, false, __ATOMIC_RELEASE);
+}
+
+template <class T>
+inline bool LSkipRing<T>::RetrieveRec(T *pRec)
+{
+	return (1 == RetrieveRecs(pRec, 1));
+}
+
+template <class T>
+inline void LSkipRing<T>::CopyOut(void *pDest, const void *pSrc, unsigned int nFirstSlot, unsigned int nNumRecs, unsigned int nNumSlots, size_t nRecSize)
+{
+	//The records occupy at most two contiguous runs of slots.
+	unsigned int nNumRecsInFirstSpan = nNumSlots - nFirstSlot;
+	if (nNumRecsInFirstSpan > nNumRecs)
+		nNumRecsInFirstSpan = nNumRecs;
+	memcpy(pDest, ((const char *) pSrc) + nFirstSlot*nRecSize, nNumRecsInFirstSpan*nRecSize);
+	if (nNumRecs > nNumRecsInFirstSpan)
+		memcpy(((char *) pDest) + nNumRecsInFirstSpan*nRecSize, pSrc, (nNumRecs - nNumRecsInFirstSpan)*nRecSize);
+}
+
+template <class T>
+inline int LSkipRing<T>::RetrieveRecs(T *pRecs, int nMaxRecs, unsigned char *pTags, unsigned long long *pTimestamps)
+{
+	unsigned int nFirstRec = __atomic_load_n(&m_nFirstRec, __ATOMIC_ACQUIRE);
+	while (nMaxRecs > 0)
+	{
+		unsigned int nNumRecs = __atomic_load_n(&m_nNextRec, __ATOMIC_ACQUIRE) - nFirstRec;
+		if (0 == nNumRecs)
+			break;
+		if (nNumRecs > (unsigned int) nMaxRecs)
+			nNumRecs = nMaxRecs;
+
+		CopyOut(pRecs, m_pRecs, nFirstRec & m_nMask, nNumRecs, m_nMask + 1, sizeof(T));
+		if (pTags)
+		{
+			if (m_pTags)
+				CopyOut(pTags, m_pTags, nFirstRec & m_nMask, nNumRecs, m_nMask + 1, 1);
+			else
+				memset(pTags, 0, nNumRecs);
+		}
+		if (pTimestamps)
+		{
+			if (m_pTimestamps)
+				CopyOut(pTimestamps, m_pTimestamps, nFirstRec & m_nMask, nNumRecs, m_nMask + 1, sizeof(unsigned long long));
+			else
+				memset(pTimestamps, 0, nNumRecs*sizeof(unsigned long long));
+		}
+
+		//The copy is only kept if the records were still queued when we claim them. If the producer dropped any of
+		//them in the meantime their slots may have been overwritten under us, so copy again from the new oldest record.
+		if (__atomic_compare_exchange_n(&m_nFirstRec, &nFirstRec, nFirstRec + nNumRecs, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			return (int) nNumRecs;
+	}
+	return 0;
+}
+
+template <class T>
+inline int LSkipRing<T>::CopyNewestRecs(T *pRecs, int nMaxRecs, unsigned long long *pTimestamps)
+{
+	unsigned int nNumSlots = m_nMask + 1;
+	while (nMaxRecs > 0)
+	{
+		unsigned int nNextRec = __atomic_load_n(&m_nNextRec, __ATOMIC_ACQUIRE);
+		unsigned int nNumRecs = nNextRec - m_nHistoryFirstRec;
+		if (nNumRecs > m_nCapacity)
+		{
+			//Keep m_nHistoryFirstRec within a lap of m_nNextRec, so the difference can not wrap.
+			nNumRecs = m_nCapacity;
+			m_nHistoryFirstRec = nNextRec - m_nCapacity;
+		}
+		if (nNumRecs > (unsigned int) nMaxRecs)
+			nNumRecs = nMaxRecs;
+		if (0 == nNumRecs)
+			break;
+
+		unsigned int nStartRec = nNextRec - nNumRecs;
+		CopyOut(pRecs, m_pRecs, nStartRec & m_nMask, nNumRecs, nNumSlots, sizeof(T));
+		if (pTimestamps)
+		{
+			if (m_pTimestamps)
+				CopyOut(pTimestamps, m_pTimestamps, nStartRec & m_nMask, nNumRecs, nNumSlots, sizeof(unsigned long long));
+			else
+				memset(pTimestamps, 0, nNumRecs*sizeof(unsigned long long));
+		}
+
+		//The producer writes a slot before it publishes the record, so the oldest slot we copied can only have been
+		//reused if the published m_nNextRec has come a full lap since. Otherwise copy again, it is the newest records that count.
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if ((__atomic_load_n(&m_nNextRec, __ATOMIC_ACQUIRE) - nStartRec) < nNumSlots)
+			return (int) nNumRecs;
+	}
+	return 0;
+}
+
+template <class T>
+inline void LSkipRing<T>::Clear()
+{
+	unsigned int nFirstRec = __atomic_load_n(&m_nFirstRec, __ATOMIC_ACQUIRE);
+	unsigned int nNextRec;
+	do
+	{
+		nNextRec = __atomic_load_n(&m_nNextRec, __ATOMIC_ACQUIRE);
+	} while (!__atomic_compare_exchange_n(&m_nFirstRec, &nFirstRec, nNextRec, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+	m_nHistoryFirstRec = nNextRec;
+}
+
+template <class T>
+inline void LSkipRing<T>::SetOptions(int numRecs, int nOverflowPolicy, int nBlockTimeoutMs)
+{
+	T *pOldRecs = m_pRecs;
+	unsigned char *pOldTags = m_pTags;
+	unsigned long long *pOldTimestamps = m_pTimestamps;
+	unsigned int nOldMask = m_nMask;
+
+	__atomic_store_n(&m_bResizing, true, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&m_bProducerBusy, __ATOMIC_SEQ_CST))
+		GUtils::Sleep(1);
+
+	//The producer is parked, so the indices can only change here.
+	unsigned int nFirstRec = m_nFirstRec;
+	unsigned int nNextRec = m_nNextRec;
+	Allocate(numRecs);
+	if ((nNextRec - nFirstRec) > m_nCapacity)
+	{
+		__atomic_store_n(&m_nNumRecsDropped, m_nNumRecsDropped + ((nNextRec - nFirstRec) - m_nCapacity), __ATOMIC_RELAXED);
+		nFirstRec = nNextRec - m_nCapacity;
+	}
+	unsigned int nNumRecs = nNextRec - nFirstRec;
+	CopyOut(m_pRecs, pOldRecs, nFirstRec & nOldMask, nNumRecs, nOldMask + 1, sizeof(T));
+	if (m_pTags)
+		CopyOut(m_pTags, pOldTags, nFirstRec & nOldMask, nNumRecs, nOldMask + 1, 1);
+	if (m_pTimestamps)
+		CopyOut(m_pTimestamps, pOldTimestamps, nFirstRec & nOldMask, nNumRecs, nOldMask + 1, sizeof(unsigned long long));
+	m_nFirstRec = 0;
+	m_nHistoryFirstRec = 0;
+	m_nNextRec = nNumRecs;
+	m_nOverflowPolicy = nOverflowPolicy;
+	m_nBlockTimeoutMs = nBlockTimeoutMs;
+
+	__atomic_store_n(&m_bResizing, false, __ATOMIC_SEQ_CST);
+	delete [] pOldRecs;
+	delete [] pOldTags;
+	delete [] pOldTimestamps;
+}
+
+template <class T>
+inline int LSkipRing<T>::NumRecsAvailable()
+{
+	//Load m_nFirstRec first, m_nNextRec can only have grown since.
+	unsigned int nFirstRec = __atomic_load_n(&m_nFirstRec, __ATOMIC_ACQUIRE);
+	unsigned int nNumRecs = __atomic_load_n(&m_nNextRec, __ATOMIC_ACQUIRE) - nFirstRec;
+	if (nNumRecs > m_nCapacity)
+		nNumRecs = m_nCapacity;
+	return (int) nNumRecs;
+}
+
+#ifdef LIB_NAMESPACE
+}
+#endif
+
+#endif // _LSKIPRING_H_
@@ -117,6 +117,15 @@ StringVector GSkipBaseDevice::OSGetAvailableDevicesOfType(int nVendorID, int nPr
 	return vPortNames;
 }
 
+int GSkipBaseDevice::OSSetDeviceNotificationCallback(DeviceNotificationFunctionPtr /*pFunction*/, void * /*pContext*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+void GSkipBaseDevice::OSReleaseDeviceRegistry(void)
+{
+}
+
 int GSkipBaseDevice::OSOpen(GPortRef * /*pPortRef*/)
 {
 	int nResult = kResponse_Error;
@@ -342,6 +351,19 @@ int GSkipBaseDevice::OSCmdRespPacketsAvailable(void)
 	return nReturn;
 }
 
+int GSkipBaseDevice::OSWaitForCmdRespPackets(int nTimeoutMs)
+{
+	//No arrival notification on this platform, so just poll.
+	int nPackets = OSCmdRespPacketsAvailable();
+	if ((0 == nPackets) && (nTimeoutMs > 0))
+	{
+		GUtils::Sleep((nTimeoutMs < 10) ? nTimeoutMs : 10);
+		nPackets = OSCmdRespPacketsAvailable();
+	}
+
+	return nPackets;
+}
+
 int local_ClearPacketQueue(GSkipBaseDevice *pDevice, int nPipe)
 {
 	TUSBBulkDevice usbDevice = static_cast<TUSBBulkDevice>(pDevice->GetOSData());
@@ -379,3 +401,31 @@ int GSkipBaseDevice::OSClearCmdRespPacketQueue()
 
 	return nReturn;
 }
+
+int GSkipBaseDevice::OSReadMeasurements(int * /*pMeasurements*/, unsigned char * /*pSequenceNumbers*/, unsigned long long * /*pTimestampsNs*/,
+	int *pIONumMeasurements, int /*nBufferSizeInMeasurements*/, unsigned char * /*pNumMeasurementsInLastPacket*/)
+{
+	(*pIONumMeasurements) = 0;
+	return kResponse_Error;//Not supported on this platform, measurement packets are queued instead.
+}
+
+int GSkipBaseDevice::OSSetMeasurementQueueOptions(int /*nCapacity*/, int /*nOverflowPolicy*/, int /*nBlockTimeoutMs*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+int GSkipBaseDevice::OSGetMeasurementQueueOverflowCount(unsigned int * /*pNumDropped*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+int GSkipBaseDevice::OSPeekLatestMeasurement(int * /*pMeasurement*/, unsigned long long * /*pTimestampNs*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+int GSkipBaseDevice::OSCopyRecentMeasurements(int * /*pMeasurements*/, unsigned long long * /*pTimestampsNs*/, int *pIONumMeasurements)
+{
+	(*pIONumMeasurements) = 0;
+	return kResponse_Error;//Not supported on this platform.
+}
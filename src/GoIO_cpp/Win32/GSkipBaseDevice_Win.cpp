@@ -822,6 +822,19 @@ int GSkipBaseDevice::OSCmdRespPacketsAvailable()
 	return nPackets;
 }
 
+int GSkipBaseDevice::OSWaitForCmdRespPackets(int nTimeoutMs)
+{
+	//No arrival notification on this platform, so just poll.
+	int nPackets = OSCmdRespPacketsAvailable();
+	if ((0 == nPackets) && (nTimeoutMs > 0))
+	{
+		GUtils::Sleep((nTimeoutMs < 10) ? nTimeoutMs : 10);
+		nPackets = OSCmdRespPacketsAvailable();
+	}
+
+	return nPackets;
+}
+
 int GSkipBaseDevice::OSClearIO()
 {
 	int nResult = kResponse_OK;
@@ -888,6 +901,34 @@ int GSkipBaseDevice::OSClearCmdRespPacketQueue()
 	return nResult;
 }
 
+int GSkipBaseDevice::OSReadMeasurements(int * /*pMeasurements*/, unsigned char * /*pSequenceNumbers*/, unsigned long long * /*pTimestampsNs*/,
+	int *pIONumMeasurements, int /*nBufferSizeInMeasurements*/, unsigned char * /*pNumMeasurementsInLastPacket*/)
+{
+	(*pIONumMeasurements) = 0;
+	return kResponse_Error;//Not supported on this platform, measurement packets are queued instead.
+}
+
+int GSkipBaseDevice::OSSetMeasurementQueueOptions(int /*nCapacity*/, int /*nOverflowPolicy*/, int /*nBlockTimeoutMs*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+int GSkipBaseDevice::OSGetMeasurementQueueOverflowCount(unsigned int * /*pNumDropped*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+int GSkipBaseDevice::OSPeekLatestMeasurement(int * /*pMeasurement*/, unsigned long long * /*pTimestampNs*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+int GSkipBaseDevice::OSCopyRecentMeasurements(int * /*pMeasurements*/, unsigned long long * /*pTimestampsNs*/, int *pIONumMeasurements)
+{
+	(*pIONumMeasurements) = 0;
+	return kResponse_Error;//Not supported on this platform.
+}
+
 StringVector GSkipBaseDevice::OSGetAvailableDevicesOfType(int nVendorID, // VERNIER
 														  int nProductID) // Go! Temp etc.
 { // RETURN a string vector with the names of all devices of the desired type
@@ -900,3 +941,12 @@ StringVector GSkipBaseDevice::OSGetAvailableDevicesOfType(int nVendorID, // VERN
 
 	return vsNames;
 }
+
+int GSkipBaseDevice::OSSetDeviceNotificationCallback(DeviceNotificationFunctionPtr /*pFunction*/, void * /*pContext*/)
+{
+	return kResponse_Error;//Not supported on this platform.
+}
+
+void GSkipBaseDevice::OSReleaseDeviceRegistry(void)
+{
+}